@@ -0,0 +1,28 @@
+{
+  'target_defaults': {
+    'defines': [
+      'NAPI_VERSION=9',
+      'NAPI_DISABLE_CPP_EXCEPTIONS',
+      'NODE_ADDON_API_ENABLE_MAYBE'
+    ],
+    'include_dirs': [
+      "<!(node -p \"require('node-addon-api').include_dir\")"
+    ],
+  },
+  'targets': [
+    {
+      'target_name': 'nativec',
+      'sources': [
+        'src/lib.c',
+        'src/fib.c',
+      ],
+    },
+    {
+      'target_name': 'nativecpp',
+      'sources': [
+        'src/lib.cpp',
+        'src/fib.c',
+      ],
+    },
+  ]
+}
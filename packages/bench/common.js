@@ -0,0 +1,35 @@
+const fs = require('fs')
+const path = require('path')
+
+function writeJSON (file, data) {
+  fs.mkdirSync(path.dirname(file), { recursive: true })
+  fs.writeFileSync(file, JSON.stringify(data, null, 2) + '\n')
+}
+
+function readJSON (file) {
+  return JSON.parse(fs.readFileSync(file, 'utf8'))
+}
+
+// Print the relative change of every result that also exists in the
+// baseline and return the names of those worse than `threshold`.
+function compare (results, baseline, threshold) {
+  const regressions = []
+  console.log('')
+  console.log(`Comparing with baseline (threshold ${(threshold * 100).toFixed(1)}%)`)
+  for (const name of Object.keys(results)) {
+    const base = baseline.results[name]
+    if (!base) continue
+    const current = results[name]
+    const change = current.higherIsBetter
+      ? current.value / base.value - 1
+      : base.value / current.value - 1
+    const regressed = change < -threshold
+    if (regressed) regressions.push(name)
+    console.log(`${regressed ? '!' : ' '} ${name.padEnd(40)} ${(change >= 0 ? '+' : '') + (change * 100).toFixed(2)}%`)
+  }
+  return regressions
+}
+
+exports.writeJSON = writeJSON
+exports.readJSON = readJSON
+exports.compare = compare
@@ -0,0 +1,144 @@
+// Native vs wasm parity benchmark.
+//
+//   node ./parity.js [--output <file>] [--baseline <file>] [--threshold 0.1]
+//                    [--update-baseline] [--filter <regexp>] [--max-time <seconds>]
+//
+// src/lib.c and src/lib.cpp are built twice: once as native addons by
+// node-gyp (npm run rebuild:native, see binding.gyp) and once with emnapi
+// (npm run rebuild). Every workload is run against both builds and the
+// overhead ratio (native ops/s divided by wasm ops/s) is reported,
+// so 1 means no overhead and 3 means the wasm build is three times slower.
+// When a baseline is given, the process exits with code 1 if any ratio
+// grows by more than the threshold.
+
+const path = require('path')
+const fs = require('fs')
+const Benchmark = require('benchmark')
+const emnapi = require('@emnapi/runtime')
+const { writeJSON, readJSON, compare } = require('./common.js')
+
+const context = emnapi.getDefaultContext()
+
+const workloads = {
+  emptyFunction: (m) => () => { m.emptyFunction() },
+  returnParam: (m) => {
+    const param = {}
+    return () => { m.returnParam(param) }
+  },
+  convertInteger: (m) => () => { m.convertInteger(1) },
+  convertString: (m) => () => { m.convertString('node-api') },
+  objectGet: (m) => {
+    const obj = { length: 1 }
+    return () => { m.objectGet(obj) }
+  },
+  objectSet: (m) => {
+    const obj = { length: 1 }
+    return () => { m.objectSet(obj, 'length', obj.length + 1) }
+  },
+  fib: (m) => () => { m.fib(24) }
+}
+
+function parseArgs (argv) {
+  const options = {
+    output: path.join(__dirname, '.build/parity.json'),
+    baseline: path.join(__dirname, 'baseline/parity.json'),
+    threshold: 0.1,
+    updateBaseline: false,
+    filter: null,
+    maxTime: 1
+  }
+  for (let i = 0; i < argv.length; ++i) {
+    const arg = argv[i]
+    switch (arg) {
+      case '--output': options.output = argv[++i]; break
+      case '--baseline': options.baseline = argv[++i]; break
+      case '--threshold': options.threshold = Number(argv[++i]); break
+      case '--update-baseline': options.updateBaseline = true; break
+      case '--filter': options.filter = new RegExp(argv[++i]); break
+      case '--max-time': options.maxTime = Number(argv[++i]); break
+      default: throw new Error(`Unknown option: ${arg}`)
+    }
+  }
+  return options
+}
+
+function measure (fn, maxTime) {
+  const bench = new Benchmark(fn, { maxTime })
+  bench.run({ async: false })
+  if (bench.error) throw bench.error
+  return { hz: bench.hz, rme: bench.stats.rme }
+}
+
+async function main () {
+  const options = parseArgs(process.argv.slice(2))
+  const [emnapic, emnapicpp] = await Promise.all([
+    require('./.build/Release/emnapic')(),
+    require('./.build/Release/emnapicpp')()
+  ])
+  const pairs = {
+    c: {
+      native: require('./build/Release/nativec.node'),
+      wasm: emnapic.emnapiInit({ context })
+    },
+    cpp: {
+      native: require('./build/Release/nativecpp.node'),
+      wasm: emnapicpp.emnapiInit({ context })
+    }
+  }
+
+  console.log(`emnapi parity benchmark (node ${process.version})`)
+  console.log('')
+
+  const results = {}
+  for (const lang of Object.keys(pairs)) {
+    const { native, wasm } = pairs[lang]
+    for (const name of Object.keys(workloads)) {
+      const key = `${lang}/${name}`
+      if (options.filter !== null && !options.filter.test(key)) continue
+      const n = measure(workloads[name](native), options.maxTime)
+      const w = measure(workloads[name](wasm), options.maxTime)
+      const ratio = n.hz / w.hz
+      results[key] = {
+        unit: 'ratio',
+        higherIsBetter: false,
+        value: ratio,
+        native: n,
+        wasm: w
+      }
+      console.log(`${key.padEnd(24)} native ${Math.round(n.hz).toLocaleString().padStart(14)} ops/s   wasm ${Math.round(w.hz).toLocaleString().padStart(14)} ops/s   x${ratio.toFixed(2)}`)
+    }
+  }
+
+  const report = {
+    node: process.version,
+    platform: process.platform,
+    arch: process.arch,
+    date: new Date().toISOString(),
+    results
+  }
+  writeJSON(options.output, report)
+  console.log('')
+  console.log(`Results written to ${options.output}`)
+
+  if (options.updateBaseline) {
+    writeJSON(options.baseline, report)
+    console.log(`Baseline written to ${options.baseline}`)
+    return 0
+  }
+
+  if (fs.existsSync(options.baseline)) {
+    const regressions = compare(results, readJSON(options.baseline), options.threshold)
+    if (regressions.length > 0) {
+      console.error(`\n${regressions.length} regression(s): ${regressions.join(', ')}`)
+      return 1
+    }
+  }
+  return 0
+}
+
+main().then((code) => {
+  process.exit(code)
+}, (err) => {
+  console.error(err)
+  process.exit(1)
+})
@@ -0,0 +1,104 @@
+// Small allocations from several threads at once, built for bare wasm32
+// once per thread safe allocator (dlmalloc-mt, emmalloc-mt, tlmalloc-mt).
+// There is no libc, so this file only uses Node-API.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <node_api.h>
+#include "../../test/common.h"
+
+void* malloc(size_t size);
+void free(void* p);
+
+#define MAX_THREADS 16
+#define LIVE_COUNT 64
+
+typedef struct {
+  napi_async_work work;
+  int32_t iterations;
+  uint32_t seed;
+  int failed;
+} malloc_work;
+
+static malloc_work works[MAX_THREADS];
+static int32_t pending;
+static int failed;
+static napi_ref done_ref;
+
+// keeps LIVE_COUNT blocks of 8 to 519 bytes alive and
+// replaces a random one per iteration
+static void SmallAllocExecute(napi_env env, void* data) {
+  malloc_work* w = (malloc_work*) data;
+  void* live[LIVE_COUNT];
+  uint32_t seed = w->seed;
+  int32_t i;
+  for (i = 0; i < LIVE_COUNT; i++) live[i] = NULL;
+  for (i = 0; i < w->iterations; i++) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t slot = (seed >> 8) % LIVE_COUNT;
+    free(live[slot]);
+    live[slot] = malloc(8 + ((seed >> 16) & 511));
+    if (live[slot] == NULL) {
+      w->failed = 1;
+      break;
+    }
+    *(volatile unsigned char*) live[slot] = (unsigned char) i;
+  }
+  for (i = 0; i < LIVE_COUNT; i++) free(live[i]);
+}
+
+static void SmallAllocComplete(napi_env env, napi_status status, void* data) {
+  malloc_work* w = (malloc_work*) data;
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, w->work));
+  if (status != napi_ok || w->failed) failed = 1;
+  if (--pending > 0) return;
+
+  napi_value cb;
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, done_ref, &cb));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, done_ref));
+  done_ref = NULL;
+  if (failed) {
+    napi_throw_error(env, NULL, "malloc failed");
+    return;
+  }
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, cb, cb, 0, NULL, NULL));
+}
+
+// mallocSmall(threads, iterations, done)
+static napi_value MallocSmall(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3], name;
+  int32_t threads, iterations;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_ASSERT(env, pending == 0, "Previous run is still going");
+  NAPI_CALL(env, napi_get_value_int32(env, argv[0], &threads));
+  NAPI_CALL(env, napi_get_value_int32(env, argv[1], &iterations));
+  NAPI_ASSERT(env, threads > 0 && threads <= MAX_THREADS, "Wrong number of threads");
+  NAPI_CALL(env, napi_create_reference(env, argv[2], 1, &done_ref));
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, "MallocSmall", NAPI_AUTO_LENGTH, &name));
+  failed = 0;
+  for (int32_t i = 0; i < threads; i++) {
+    works[i].iterations = iterations;
+    works[i].seed = (uint32_t) i + 1;
+    works[i].failed = 0;
+    NAPI_CALL(env, napi_create_async_work(env, NULL, name, SmallAllocExecute,
+        SmallAllocComplete, &works[i], &works[i].work));
+  }
+  pending = threads;
+  for (int32_t i = 0; i < threads; i++) {
+    NAPI_CALL(env, napi_queue_async_work(env, works[i].work));
+  }
+  return NULL;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NAPI_PROPERTY("mallocSmall", MallocSmall),
+  };
+  NAPI_CALL(env, napi_define_properties(
+      env, exports, sizeof(properties) / sizeof(*properties), properties));
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
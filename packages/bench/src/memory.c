@@ -0,0 +1,9 @@
+// memcpy.c and memset.c of the wasm32 malloc libraries under other
+// names, so that suite.js can compare them with the ones of libc
+// and tune BULK_MEMORY_THRESHOLD.
+
+#define memcpy bench_memcpy
+#define memset bench_memset
+
+#include "../../emnapi/src/malloc/memcpy.c"
+#include "../../emnapi/src/malloc/memset.c"
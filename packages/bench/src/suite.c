@@ -0,0 +1,414 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <node_api.h>
+#ifdef __wasm__
+#include <emnapi.h>
+#endif
+#include "../../test/common.h"
+
+#define CLASS_METHOD_MAX 300
+#define SCRATCH_SIZE 65536
+
+static napi_ref persistent_ref = NULL;
+static char scratch[SCRATCH_SIZE];
+static char method_names[CLASS_METHOD_MAX][5];
+static napi_property_descriptor class_methods[CLASS_METHOD_MAX];
+static napi_property_descriptor class_methods_configurable[CLASS_METHOD_MAX];
+
+static uint32_t get_uint32_arg(napi_env env, napi_callback_info info, napi_value* rest) {
+  size_t argc = 2;
+  napi_value argv[2];
+  uint32_t value = 0;
+  napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+  napi_get_value_uint32(env, argv[0], &value);
+  if (rest != NULL) *rest = argv[1];
+  return value;
+}
+
+static napi_value get_arg(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv;
+  napi_get_cb_info(env, info, &argc, &argv, NULL, NULL);
+  return argv;
+}
+
+// refs and wrap
+
+static napi_value ref_create_delete(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info), ret;
+  napi_ref ref;
+  NAPI_CALL(env, napi_create_reference(env, value, 1, &ref));
+  NAPI_CALL(env, napi_get_reference_value(env, ref, &ret));
+  NAPI_CALL(env, napi_delete_reference(env, ref));
+  return ret;
+}
+
+static napi_value ref_get(napi_env env, napi_callback_info info) {
+  napi_value ret;
+  NAPI_CALL(env, napi_get_reference_value(env, persistent_ref, &ret));
+  return ret;
+}
+
+static napi_value create_wrapped(napi_env env, napi_callback_info info) {
+  napi_value ret;
+  NAPI_CALL(env, napi_create_object(env, &ret));
+  NAPI_CALL(env, napi_wrap(env, ret, scratch, NULL, NULL, NULL));
+  return ret;
+}
+
+static napi_value wrap_unwrap(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info);
+  void* data;
+  NAPI_CALL(env, napi_wrap(env, value, scratch, NULL, NULL, NULL));
+  NAPI_CALL(env, napi_unwrap(env, value, &data));
+  NAPI_CALL(env, napi_remove_wrap(env, value, &data));
+  return NULL;
+}
+
+static napi_value unwrap(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info);
+  void* data;
+  NAPI_CALL(env, napi_unwrap(env, value, &data));
+  return NULL;
+}
+
+// typed arrays and buffers
+
+static napi_value create_arraybuffer(napi_env env, napi_callback_info info) {
+  uint32_t size = get_uint32_arg(env, info, NULL);
+  void* data;
+  napi_value ret;
+  NAPI_CALL(env, napi_create_arraybuffer(env, size, &data, &ret));
+  return ret;
+}
+
+// the length is passed in, napi_get_arraybuffer_info would copy
+// an ArrayBuffer living outside wasm memory into a mirror first
+static napi_value create_typedarray(napi_env env, napi_callback_info info) {
+  napi_value arraybuffer, ret;
+  uint32_t length = get_uint32_arg(env, info, &arraybuffer);
+  NAPI_CALL(env, napi_create_typedarray(env, napi_uint8_array, length, arraybuffer, 0, &ret));
+  return ret;
+}
+
+static napi_value get_arraybuffer_info(napi_env env, napi_callback_info info) {
+  napi_value arraybuffer = get_arg(env, info);
+  void* data;
+  size_t byte_length;
+  NAPI_CALL(env, napi_get_arraybuffer_info(env, arraybuffer, &data, &byte_length));
+  return NULL;
+}
+
+static napi_value get_typedarray_info(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info), arraybuffer;
+  napi_typedarray_type type;
+  size_t length, byte_offset;
+  void* data;
+  NAPI_CALL(env, napi_get_typedarray_info(env, value, &type, &length, &data, &arraybuffer, &byte_offset));
+  return NULL;
+}
+
+static napi_value create_buffer_copy(napi_env env, napi_callback_info info) {
+  uint32_t size = get_uint32_arg(env, info, NULL);
+  void* data;
+  napi_value ret;
+  NAPI_ASSERT(env, size <= SCRATCH_SIZE, "size is too large");
+  NAPI_CALL(env, napi_create_buffer_copy(env, size, scratch, &data, &ret));
+  return ret;
+}
+
+static napi_value get_buffer_info(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info);
+  void* data;
+  size_t length;
+  NAPI_CALL(env, napi_get_buffer_info(env, value, &data, &length));
+  return NULL;
+}
+
+// memcpy / memset, libc and src/malloc ones
+
+void* bench_memcpy(void* restrict dest, const void* restrict src, size_t n);
+void* bench_memset(void* dest, int c, size_t n);
+
+#define MEMORY_LOOP 100
+
+static napi_value copy_memory(napi_env env, napi_callback_info info) {
+  napi_value own;
+  uint32_t size = get_uint32_arg(env, info, &own);
+  bool use_own;
+  NAPI_ASSERT(env, size <= SCRATCH_SIZE / 2, "size is too large");
+  NAPI_CALL(env, napi_get_value_bool(env, own, &use_own));
+  for (int i = 0; i < MEMORY_LOOP; ++i) {
+    if (use_own) {
+      bench_memcpy(scratch + SCRATCH_SIZE / 2, scratch + (i & 7), size);
+    } else {
+      memcpy(scratch + SCRATCH_SIZE / 2, scratch + (i & 7), size);
+    }
+  }
+  return NULL;
+}
+
+static napi_value fill_memory(napi_env env, napi_callback_info info) {
+  napi_value own;
+  uint32_t size = get_uint32_arg(env, info, &own);
+  bool use_own;
+  NAPI_ASSERT(env, size <= SCRATCH_SIZE - 8, "size is too large");
+  NAPI_CALL(env, napi_get_value_bool(env, own, &use_own));
+  for (int i = 0; i < MEMORY_LOOP; ++i) {
+    if (use_own) {
+      bench_memset(scratch + (i & 7), i, size);
+    } else {
+      memset(scratch + (i & 7), i, size);
+    }
+  }
+  return NULL;
+}
+
+// strings
+
+static napi_value convert_string_utf8(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info), ret;
+  size_t len = 0;
+  NAPI_CALL(env, napi_get_value_string_utf8(env, value, NULL, 0, &len));
+  char* buf = (char*) malloc(len + 1);
+  NAPI_CALL(env, napi_get_value_string_utf8(env, value, buf, len + 1, &len));
+  NAPI_CALL(env, napi_create_string_utf8(env, buf, len, &ret));
+  free(buf);
+  return ret;
+}
+
+static napi_value convert_string_utf16(napi_env env, napi_callback_info info) {
+  napi_value value = get_arg(env, info), ret;
+  size_t len = 0;
+  NAPI_CALL(env, napi_get_value_string_utf16(env, value, NULL, 0, &len));
+  char16_t* buf = (char16_t*) malloc((len + 1) * sizeof(char16_t));
+  NAPI_CALL(env, napi_get_value_string_utf16(env, value, buf, len + 1, &len));
+  NAPI_CALL(env, napi_create_string_utf16(env, buf, len, &ret));
+  free(buf);
+  return ret;
+}
+
+// promises
+
+static napi_value promise_resolve(napi_env env, napi_callback_info info) {
+  napi_deferred deferred;
+  napi_value promise, undefined;
+  NAPI_CALL(env, napi_create_promise(env, &deferred, &promise));
+  NAPI_CALL(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL(env, napi_resolve_deferred(env, deferred, undefined));
+  return promise;
+}
+
+// handle scopes
+
+static napi_value scope_churn(napi_env env, napi_callback_info info) {
+  uint32_t count = get_uint32_arg(env, info, NULL);
+  napi_handle_scope scope;
+  napi_value value;
+  for (uint32_t i = 0; i < count; ++i) {
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    NAPI_CALL(env, napi_create_object(env, &value));
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
+// define_class
+
+static napi_value class_constructor(napi_env env, napi_callback_info info) {
+  napi_value thiz;
+  NAPI_CALL(env, napi_get_cb_info(env, info, NULL, NULL, &thiz, NULL));
+  return thiz;
+}
+
+static napi_value class_method(napi_env env, napi_callback_info info) {
+  return NULL;
+}
+
+static napi_value define_class(napi_env env, napi_callback_info info) {
+  uint32_t count = get_uint32_arg(env, info, NULL);
+  napi_value ret;
+  NAPI_ASSERT(env, count <= CLASS_METHOD_MAX, "too many methods");
+  NAPI_CALL(env, napi_define_class(env, "BenchClass", NAPI_AUTO_LENGTH,
+    class_constructor, NULL, count, class_methods, &ret));
+  return ret;
+}
+
+// methods defined by node-addon-api's ObjectWrap are usually configurable
+static napi_value define_class_configurable(napi_env env, napi_callback_info info) {
+  uint32_t count = get_uint32_arg(env, info, NULL);
+  napi_value ret;
+  NAPI_ASSERT(env, count <= CLASS_METHOD_MAX, "too many methods");
+  NAPI_CALL(env, napi_define_class(env, "BenchClass", NAPI_AUTO_LENGTH,
+    class_constructor, NULL, count, class_methods_configurable, &ret));
+  return ret;
+}
+
+// same methods, created on first access
+static napi_value define_class_lazy(napi_env env, napi_callback_info info) {
+  uint32_t count = get_uint32_arg(env, info, NULL);
+  napi_value ret, prototype;
+  NAPI_ASSERT(env, count <= CLASS_METHOD_MAX, "too many methods");
+  NAPI_CALL(env, napi_define_class(env, "BenchClass", NAPI_AUTO_LENGTH,
+    class_constructor, NULL, 0, NULL, &ret));
+  NAPI_CALL(env, napi_get_named_property(env, ret, "prototype", &prototype));
+#ifdef __wasm__
+  NAPI_CALL(env, emnapi_define_lazy_properties(env, prototype, count, class_methods_configurable));
+#else
+  NAPI_CALL(env, napi_define_properties(env, prototype, count, class_methods_configurable));
+#endif
+  return ret;
+}
+
+// async work
+
+typedef struct {
+  napi_async_work work;
+  napi_ref callback;
+  uint32_t busy_us;
+} work_data;
+
+static void work_execute(napi_env env, void* data) {}
+
+static void busy_work_execute(napi_env env, void* data) {
+  work_data* c = (work_data*) data;
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  } while ((now.tv_sec - start.tv_sec) * 1000000 +
+           (now.tv_nsec - start.tv_nsec) / 1000 < c->busy_us);
+}
+
+static void work_complete(napi_env env, napi_status status, void* data) {
+  work_data* c = (work_data*) data;
+  napi_value callback, undefined;
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, c->callback, &callback));
+  NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, c->callback));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, c->work));
+  free(c);
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, undefined, callback, 0, NULL, NULL));
+}
+
+static napi_value queue_work(napi_env env, napi_callback_info info) {
+  napi_value callback = get_arg(env, info), resource_name;
+  work_data* c = (work_data*) malloc(sizeof(work_data));
+  NAPI_CALL(env, napi_create_reference(env, callback, 1, &c->callback));
+  NAPI_CALL(env, napi_create_string_utf8(env, "BenchWork", NAPI_AUTO_LENGTH, &resource_name));
+  NAPI_CALL(env, napi_create_async_work(env, NULL, resource_name,
+    work_execute, work_complete, c, &c->work));
+  NAPI_CALL(env, napi_queue_async_work(env, c->work));
+  return NULL;
+}
+
+// keeps a worker busy for the given number of microseconds
+static napi_value queue_busy_work(napi_env env, napi_callback_info info) {
+  napi_value callback, resource_name;
+  uint32_t busy_us = get_uint32_arg(env, info, &callback);
+  work_data* c = (work_data*) malloc(sizeof(work_data));
+  c->busy_us = busy_us;
+  NAPI_CALL(env, napi_create_reference(env, callback, 1, &c->callback));
+  NAPI_CALL(env, napi_create_string_utf8(env, "BenchBusyWork", NAPI_AUTO_LENGTH, &resource_name));
+  NAPI_CALL(env, napi_create_async_work(env, NULL, resource_name,
+    busy_work_execute, work_complete, c, &c->work));
+  NAPI_CALL(env, napi_queue_async_work(env, c->work));
+  return NULL;
+}
+
+// threadsafe function
+
+typedef struct {
+  uint32_t count;
+  napi_async_work work;
+  napi_threadsafe_function tsfn;
+} tsfn_data;
+
+static void tsfn_execute(napi_env env, void* data) {
+  tsfn_data* c = (tsfn_data*) data;
+  for (uint32_t i = 0; i < c->count; ++i) {
+    if (napi_call_threadsafe_function(c->tsfn, NULL, napi_tsfn_blocking) != napi_ok) {
+      break;
+    }
+  }
+}
+
+static void tsfn_complete(napi_env env, napi_status status, void* data) {
+  tsfn_data* c = (tsfn_data*) data;
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, c->work));
+  NAPI_CALL_RETURN_VOID(env, napi_release_threadsafe_function(c->tsfn, napi_tsfn_release));
+}
+
+static void tsfn_finalize(napi_env env, void* data, void* hint) {
+  free(data);
+}
+
+static void tsfn_call_js(napi_env env, napi_value js_cb, void* context, void* data) {
+  napi_value undefined;
+  if (env == NULL || js_cb == NULL) return;
+  NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, undefined, js_cb, 0, NULL, NULL));
+}
+
+static napi_value call_tsfn(napi_env env, napi_callback_info info) {
+  napi_value callback, resource_name;
+  uint32_t count = get_uint32_arg(env, info, &callback);
+  tsfn_data* c = (tsfn_data*) malloc(sizeof(tsfn_data));
+  c->count = count;
+  NAPI_CALL(env, napi_create_string_utf8(env, "BenchTsfn", NAPI_AUTO_LENGTH, &resource_name));
+  NAPI_CALL(env, napi_create_threadsafe_function(env, callback, NULL, resource_name,
+    0, 1, c, tsfn_finalize, c, tsfn_call_js, &c->tsfn));
+  NAPI_CALL(env, napi_create_async_work(env, NULL, resource_name,
+    tsfn_execute, tsfn_complete, c, &c->work));
+  NAPI_CALL(env, napi_queue_async_work(env, c->work));
+  return NULL;
+}
+
+#define EXPORT_FUNCTION(env, exports, name, f) \
+  do { \
+    napi_value f##_fn; \
+    NAPI_CALL((env), napi_create_function((env), NULL, NAPI_AUTO_LENGTH, (f), NULL, &(f##_fn))); \
+    NAPI_CALL((env), napi_set_named_property((env), (exports), (name), (f##_fn))); \
+  } while (0)
+
+NAPI_MODULE_INIT() {
+  napi_value persistent;
+  NAPI_CALL(env, napi_create_object(env, &persistent));
+  NAPI_CALL(env, napi_create_reference(env, persistent, 1, &persistent_ref));
+
+  for (int i = 0; i < CLASS_METHOD_MAX; ++i) {
+    snprintf(method_names[i], sizeof(method_names[i]), "m%d", i);
+    napi_property_descriptor desc = { method_names[i], NULL, class_method, NULL, NULL, NULL, napi_default, NULL };
+    class_methods[i] = desc;
+    desc.attributes = napi_default_method;
+    class_methods_configurable[i] = desc;
+  }
+
+  EXPORT_FUNCTION(env, exports, "refCreateDelete", ref_create_delete);
+  EXPORT_FUNCTION(env, exports, "refGet", ref_get);
+  EXPORT_FUNCTION(env, exports, "createWrapped", create_wrapped);
+  EXPORT_FUNCTION(env, exports, "wrapUnwrap", wrap_unwrap);
+  EXPORT_FUNCTION(env, exports, "unwrap", unwrap);
+  EXPORT_FUNCTION(env, exports, "createArrayBuffer", create_arraybuffer);
+  EXPORT_FUNCTION(env, exports, "getArrayBufferInfo", get_arraybuffer_info);
+  EXPORT_FUNCTION(env, exports, "createTypedArray", create_typedarray);
+  EXPORT_FUNCTION(env, exports, "getTypedArrayInfo", get_typedarray_info);
+  EXPORT_FUNCTION(env, exports, "createBufferCopy", create_buffer_copy);
+  EXPORT_FUNCTION(env, exports, "getBufferInfo", get_buffer_info);
+  EXPORT_FUNCTION(env, exports, "copyMemory", copy_memory);
+  EXPORT_FUNCTION(env, exports, "fillMemory", fill_memory);
+  EXPORT_FUNCTION(env, exports, "convertStringUtf8", convert_string_utf8);
+  EXPORT_FUNCTION(env, exports, "convertStringUtf16", convert_string_utf16);
+  EXPORT_FUNCTION(env, exports, "promiseResolve", promise_resolve);
+  EXPORT_FUNCTION(env, exports, "scopeChurn", scope_churn);
+  EXPORT_FUNCTION(env, exports, "defineClass", define_class);
+  EXPORT_FUNCTION(env, exports, "defineClassConfigurable", define_class_configurable);
+  EXPORT_FUNCTION(env, exports, "defineClassLazy", define_class_lazy);
+  EXPORT_FUNCTION(env, exports, "queueWork", queue_work);
+  EXPORT_FUNCTION(env, exports, "queueBusyWork", queue_busy_work);
+  EXPORT_FUNCTION(env, exports, "callTsfn", call_tsfn);
+
+  return exports;
+}
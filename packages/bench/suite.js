@@ -0,0 +1,346 @@
+/* eslint-disable camelcase */
+
+// Headless benchmark suite.
+//
+//   node ./suite.js [--target emscripten|wasi-threads|wasm32] [--output <file>]
+//                   [--baseline <file>] [--threshold 0.1] [--update-baseline]
+//                   [--filter <regexp>] [--max-time <seconds>]
+//
+// Results are written as JSON. When a baseline is given, every result
+// is compared with it and the process exits with code 1 if any result
+// is slower than the baseline by more than the threshold.
+//
+// The wasm32 target only compares the thread safe allocators of
+// packages/emnapi, see src/malloc_mt.c.
+
+const fs = require('fs')
+const path = require('path')
+const { Worker } = require('worker_threads')
+const { performance } = require('perf_hooks')
+const Benchmark = require('benchmark')
+const emnapi = require('@emnapi/runtime')
+const { writeJSON, readJSON, compare } = require('./common.js')
+
+const context = emnapi.getDefaultContext()
+
+function parseArgs (argv) {
+  const options = {
+    target: process.env.EMNAPI_BENCH_WASI_THREADS ? 'wasi-threads' : 'emscripten',
+    output: '',
+    baseline: '',
+    threshold: 0.1,
+    updateBaseline: false,
+    filter: null,
+    maxTime: 1
+  }
+  for (let i = 0; i < argv.length; ++i) {
+    const arg = argv[i]
+    switch (arg) {
+      case '--target': options.target = argv[++i]; break
+      case '--output': options.output = argv[++i]; break
+      case '--baseline': options.baseline = argv[++i]; break
+      case '--threshold': options.threshold = Number(argv[++i]); break
+      case '--update-baseline': options.updateBaseline = true; break
+      case '--filter': options.filter = new RegExp(argv[++i]); break
+      case '--max-time': options.maxTime = Number(argv[++i]); break
+      default: throw new Error(`Unknown option: ${arg}`)
+    }
+  }
+  if (options.target !== 'emscripten' && options.target !== 'wasi-threads' && options.target !== 'wasm32') {
+    throw new Error(`Unknown target: ${options.target}`)
+  }
+  if (!options.output) {
+    options.output = path.join(__dirname, `.build/suite-${options.target}.json`)
+  }
+  if (!options.baseline) {
+    options.baseline = path.join(__dirname, `baseline/${options.target}.json`)
+  }
+  return options
+}
+
+function loadEmscripten () {
+  return require('./.build/Release/emnapisuite')().then((Module) => {
+    return Module.emnapiInit({ context })
+  })
+}
+
+function loadWasiThreads () {
+  const { WASI } = require('@tybys/wasm-util')
+  const { createNapiModule, loadNapiModule } = require('@emnapi/core')
+  const request = path.join(__dirname, '.build/wasm32-wasi-threads/Release/emnapisuite.wasm')
+  const napiModule = createNapiModule({
+    context,
+    filename: request,
+    reuseWorker: true,
+    onCreateWorker () {
+      return new Worker(path.join(__dirname, '../test/worker.js'), {
+        env: process.env,
+        execArgv: ['--experimental-wasi-unstable-preview1']
+      })
+    }
+  })
+  return loadNapiModule(napiModule, fs.readFileSync(request), {
+    wasi: new WASI({ fs }),
+    overwriteImports (importObject) {
+      importObject.env.memory = new WebAssembly.Memory({
+        initial: 16777216 / 65536,
+        maximum: 2147483648 / 65536,
+        shared: true
+      })
+    }
+  }).then(() => napiModule.exports)
+}
+
+function loadWasm32 (name) {
+  const { createNapiModule, loadNapiModule } = require('@emnapi/core')
+  const request = path.join(__dirname, `.build/wasm32-unknown-unknown/Release/mallocmt_${name}.wasm`)
+  const napiModule = createNapiModule({
+    context,
+    filename: request,
+    asyncWorkPoolSize: ('UV_THREADPOOL_SIZE' in process.env) ? Number(process.env.UV_THREADPOOL_SIZE) : 4,
+    onCreateWorker () {
+      return new Worker(path.join(__dirname, '../test/worker.js'), {
+        env: process.env
+      })
+    }
+  })
+  return loadNapiModule(napiModule, fs.readFileSync(request), {
+    overwriteImports (importObject) {
+      importObject.env.memory = new WebAssembly.Memory({
+        initial: 16777216 / 65536,
+        maximum: 2147483648 / 65536,
+        shared: true
+      })
+    }
+  }).then(() => napiModule.exports)
+}
+
+class Runner {
+  constructor (options) {
+    this.options = options
+    this.results = {}
+  }
+
+  enabled (name) {
+    return this.options.filter === null || this.options.filter.test(name)
+  }
+
+  add (name, result) {
+    this.results[name] = result
+    const value = result.unit === 'ops/s'
+      ? `${Math.round(result.value).toLocaleString()} ops/s ±${result.rme.toFixed(2)}%`
+      : `mean ${result.value.toFixed(4)} ms, p99 ${result.p99.toFixed(4)} ms`
+    console.log(`${name.padEnd(40)} ${value}`)
+  }
+
+  // throughput of a synchronous call, measured by benchmark.js
+  sync (name, fn) {
+    if (!this.enabled(name)) return
+    const bench = new Benchmark(name, fn, { maxTime: this.options.maxTime })
+    bench.run({ async: false })
+    if (bench.error) throw bench.error
+    this.add(name, {
+      unit: 'ops/s',
+      higherIsBetter: true,
+      value: bench.hz,
+      rme: bench.stats.rme,
+      samples: bench.stats.sample.length
+    })
+  }
+
+  // round trip latency of an operation that calls `done` when finished
+  async latency (name, iterations, op) {
+    if (!this.enabled(name)) return
+    const run = () => new Promise((resolve, reject) => {
+      try { op(resolve) } catch (err) { reject(err) }
+    })
+    for (let i = 0; i < Math.min(iterations, 100); ++i) await run()
+
+    const samples = new Float64Array(iterations)
+    for (let i = 0; i < iterations; ++i) {
+      const start = performance.now()
+      await run()
+      samples[i] = performance.now() - start
+    }
+    samples.sort()
+    let total = 0
+    for (let i = 0; i < iterations; ++i) total += samples[i]
+    this.add(name, {
+      unit: 'ms',
+      higherIsBetter: false,
+      value: total / iterations,
+      p50: samples[Math.floor(iterations * 0.5)],
+      p99: samples[Math.min(iterations - 1, Math.ceil(iterations * 0.99) - 1)],
+      samples: iterations
+    })
+  }
+
+  // number of operations per second when `count` operations are in flight
+  async throughput (name, count, op) {
+    if (!this.enabled(name)) return
+    await new Promise((resolve, reject) => {
+      try { op(count, resolve) } catch (err) { reject(err) }
+    })
+    const start = performance.now()
+    await new Promise((resolve, reject) => {
+      try { op(count, resolve) } catch (err) { reject(err) }
+    })
+    const elapsed = (performance.now() - start) / 1000
+    this.add(name, {
+      unit: 'ops/s',
+      higherIsBetter: true,
+      value: count / elapsed,
+      rme: 0,
+      samples: 1
+    })
+  }
+}
+
+async function runSuite (napi, runner) {
+  // refs and wrap/unwrap
+  const obj = {}
+  const wrapped = napi.createWrapped()
+  runner.sync('ref/createDelete', () => { napi.refCreateDelete(obj) })
+  runner.sync('ref/get', () => { napi.refGet() })
+  runner.sync('wrap/wrapUnwrapRemove', () => { napi.wrapUnwrap({}) })
+  runner.sync('wrap/unwrap', () => { napi.unwrap(wrapped) })
+
+  // typed arrays and buffers
+  const arraybuffer = new ArrayBuffer(1024)
+  const typedarray = new Uint8Array(arraybuffer)
+  const buffer = Buffer.alloc(1024)
+  runner.sync('arraybuffer/create 1KiB', () => { napi.createArrayBuffer(1024) })
+  runner.sync('arraybuffer/create 64KiB', () => { napi.createArrayBuffer(65536) })
+  runner.sync('arraybuffer/info', () => { napi.getArrayBufferInfo(arraybuffer) })
+  runner.sync('typedarray/create', () => { napi.createTypedArray(1024, arraybuffer) })
+  runner.sync('typedarray/info', () => { napi.getTypedArrayInfo(typedarray) })
+  runner.sync('buffer/copy 1KiB', () => { napi.createBufferCopy(1024) })
+  runner.sync('buffer/copy 64KiB', () => { napi.createBufferCopy(65536) })
+  runner.sync('buffer/info', () => { napi.getBufferInfo(buffer) })
+
+  // memcpy / memset x100, libc against src/malloc with the
+  // EMNAPI_MEMCPY_STRATEGY and EMNAPI_BULK_MEMORY_THRESHOLD of the build
+  for (const size of [16, 32, 64, 128, 256, 512, 1024, 4096]) {
+    runner.sync(`memory/memcpy libc ${size}B`, () => { napi.copyMemory(size, false) })
+    runner.sync(`memory/memcpy emnapi ${size}B`, () => { napi.copyMemory(size, true) })
+    runner.sync(`memory/memset libc ${size}B`, () => { napi.fillMemory(size, false) })
+    runner.sync(`memory/memset emnapi ${size}B`, () => { napi.fillMemory(size, true) })
+  }
+
+  // strings
+  const sizes = [
+    ['8B', 8],
+    ['256B', 256],
+    ['4KiB', 4096],
+    ['64KiB', 65536],
+    ['1MiB', 1048576]
+  ]
+  for (const [label, size] of sizes) {
+    const str = 'a'.repeat(size)
+    runner.sync(`string/utf8 ${label}`, () => { napi.convertStringUtf8(str) })
+    runner.sync(`string/utf16 ${label}`, () => { napi.convertStringUtf16(str) })
+  }
+
+  // promises
+  runner.sync('promise/createResolve', () => { napi.promiseResolve() })
+  await runner.latency('promise/settle', 10000, (done) => { napi.promiseResolve().then(done) })
+
+  // handle scopes
+  runner.sync('scope/churn x100', () => { napi.scopeChurn(100) })
+
+  // napi_define_class
+  runner.sync('defineClass/0 methods', () => { napi.defineClass(0) })
+  runner.sync('defineClass/8 methods', () => { napi.defineClass(8) })
+  runner.sync('defineClass/32 methods', () => { napi.defineClass(32) })
+
+  // startup cost of large classes, and of calling one method of them
+  runner.sync('startup/defineClass 300 methods', () => { napi.defineClass(300) })
+  runner.sync('startup/defineClass 300 configurable', () => { napi.defineClassConfigurable(300) })
+  runner.sync('startup/defineClass 300 configurable, call 1', () => {
+    const BenchClass = napi.defineClassConfigurable(300)
+    new BenchClass().m0()
+  })
+  runner.sync('startup/defineClass 300 lazy', () => { napi.defineClassLazy(300) })
+  runner.sync('startup/defineClass 300 lazy, call 1', () => {
+    const BenchClass = napi.defineClassLazy(300)
+    new BenchClass().m0()
+  })
+
+  // async work
+  await runner.latency('asyncWork/latency', 1000, (done) => { napi.queueWork(done) })
+  await runner.throughput('asyncWork/throughput', 10000, (count, done) => {
+    let n = 0
+    const complete = () => { if (++n === count) done() }
+    for (let i = 0; i < count; ++i) napi.queueWork(complete)
+  })
+  // a burst of 1ms jobs, finishes in jobs / pool size ms once every
+  // worker is busy, anything above that is ramp-up and dispatch delay
+  await runner.latency('asyncWork/burst 64x1ms', 50, (done) => {
+    let n = 0
+    const complete = () => { if (++n === 64) done() }
+    for (let i = 0; i < 64; ++i) napi.queueBusyWork(1000, complete)
+  })
+
+  // threadsafe functions
+  await runner.latency('tsfn/latency', 1000, (done) => { napi.callTsfn(1, done) })
+  await runner.throughput('tsfn/throughput', 100000, (count, done) => {
+    let n = 0
+    napi.callTsfn(count, () => { if (++n === count) done() })
+  })
+}
+
+// small allocations from 4 threads at once, with each thread safe allocator
+async function runMallocSuite (runner) {
+  for (const name of ['dlmalloc', 'emmalloc', 'tlmalloc']) {
+    const napi = await loadWasm32(name)
+    await runner.latency(`malloc/${name}-mt 4 threads x 20000`, 20, (done) => { napi.mallocSmall(4, 20000, done) })
+  }
+}
+
+async function main () {
+  const options = parseArgs(process.argv.slice(2))
+  const runner = new Runner(options)
+
+  console.log(`emnapi benchmark suite (${options.target}, node ${process.version})`)
+  console.log('')
+  if (options.target === 'wasm32') {
+    await runMallocSuite(runner)
+  } else {
+    const napi = await (options.target === 'wasi-threads' ? loadWasiThreads() : loadEmscripten())
+    await runSuite(napi, runner)
+  }
+
+  const report = {
+    target: options.target,
+    node: process.version,
+    platform: process.platform,
+    arch: process.arch,
+    date: new Date().toISOString(),
+    results: runner.results
+  }
+  writeJSON(options.output, report)
+  console.log('')
+  console.log(`Results written to ${options.output}`)
+
+  if (options.updateBaseline) {
+    writeJSON(options.baseline, report)
+    console.log(`Baseline written to ${options.baseline}`)
+    return 0
+  }
+
+  if (fs.existsSync(options.baseline)) {
+    const regressions = compare(runner.results, readJSON(options.baseline), options.threshold)
+    if (regressions.length > 0) {
+      console.error(`\n${regressions.length} regression(s): ${regressions.join(', ')}`)
+      return 1
+    }
+  }
+  return 0
+}
+
+main().then((code) => {
+  process.exit(code)
+}, (err) => {
+  console.error(err)
+  process.exit(1)
+})
@@ -5,6 +5,7 @@ export declare interface NodeBinding {
     emitAsyncInit: Function
     emitAsyncDestroy: Function
     makeCallback: Function
+    adjustExternalMemory?: Function
   }
   napi: {
     asyncInit: Function
@@ -42,6 +43,66 @@ export declare interface PointerInfo {
   runtimeAllocated: 0 | 1
 }
 
+export declare interface ProfileApiStat {
+  name: string
+  calls: number
+  totalTime: number
+  meanTime: number
+  maxTime: number
+  p99Time: number
+  pendingExceptions: number
+  pendingExceptionRate: number
+}
+
+export declare interface ProfileSnapshot {
+  /** `false` unless built with `EMNAPI_PROFILE=1` */
+  enabled: boolean
+  timeUnit: 'ms'
+  startTime: number
+  endTime: number
+  apis: ProfileApiStat[]
+}
+
+export declare interface HeapUsage {
+  /** Size of the wasm memory, it never shrinks */
+  memorySize: number
+  /**
+   * The fields below are 0 unless the module exports
+   * `emnapi_get_heap_statistics` (`-Wl,--export=emnapi_get_heap_statistics`)
+   */
+  heapSize: number
+  usedSize: number
+  freeSize: number
+  largestFreeSize: number
+  /** Bytes of whole 64KiB pages inside free blocks */
+  freePageSize: number
+  /** `1 - largestFreeSize / freeSize` */
+  fragmentation: number
+}
+
+export declare interface MemoryGrowEvent {
+  oldByteLength: number
+  newByteLength: number
+  /** Incremented every time growth is observed */
+  generation: number
+}
+
+export declare interface MemoryViewRef<T extends ArrayBufferView> {
+  /** Always a view of the current wasm memory buffer */
+  readonly view: T
+  readonly address: number
+}
+
+export declare interface ArrayBufferTracker {
+  /** Byte range relative to the tracked buffer or view, copied into the wasm mirror on next use */
+  markDirty (offset?: number, length?: number): void
+}
+
+export declare interface MirrorStats {
+  copies: number
+  copiedBytes: number
+}
+
 export declare interface InitOptions {
   instance: WebAssembly.Instance
   module: WebAssembly.Module
@@ -67,12 +128,27 @@ export declare interface NapiModule {
       len?: int
     ): T
     getMemoryAddress (arrayBufferOrView: ArrayBuffer | ArrayBufferView): PointerInfo
+    createMemoryViewRef<T extends ArrayBufferView> (view: T): MemoryViewRef<T>
+    /**
+     * Called when wasm memory grows through `napi_adjust_external_memory`.
+     * `memory.grow` done by the allocator inside wasm cannot be observed
+     * from JS, that growth is reported the next time emnapi looks up a
+     * memory view. Returns a function that removes the listener.
+     */
+    onMemoryGrow (listener: (event: MemoryGrowEvent) => void): () => void
+    trackArrayBuffer (arrayBufferOrView: ArrayBuffer | ArrayBufferView): ArrayBufferTracker
+    setMirrorCopyOnce (enabled: boolean): void
+    getMirrorStats (arrayBufferOrView?: ArrayBuffer | ArrayBufferView): MirrorStats
+    getProfile (): ProfileSnapshot
+    resetProfile (): void
+    dumpProfile (format?: 'json' | 'trace'): string
+    getHeapUsage (): HeapUsage
   }
 
   init (options: InitOptions): any
   spawnThread (startArg: number, errorOrTid?: number): number
   startThread (tid: number, startArg: number): void
-  initWorker (arg: number): void
+  initWorker (arg: number, channel?: number): void
   executeAsyncWork (work: number): void
   postMessage?: (msg: any) => any
 }
@@ -0,0 +1,3 @@
+// createNapiModule of the EMNAPI_PROFILE=1 build, pass the module it
+// returns to loadNapiModule / loadNapiModuleSync of the default entry
+export { createNapiModule } from './index'
@@ -57,7 +57,7 @@ function build () {
     }
   }
 
-  return Promise.all(([
+  const configs = [
     {
       input: createInput('es5', false),
       output: {
@@ -128,7 +128,39 @@ function build () {
         strict: false
       }
     }
-  ]).map(conf => {
+  ]
+
+  // only there when @emnapi/emnapi was built with EMNAPI_PROFILE=1
+  if (fs.existsSync(path.join(__dirname, '../lib/es2019/module.profile.js'))) {
+    const createProfileInput = () => ({
+      input: path.join(__dirname, '../lib/es2019/module.profile.js'),
+      plugins: [
+        rollupNodeResolve({
+          mainFields: ['module', 'main'],
+          resolveOnly: [/^(?!(tslib)).*?$/]
+        })
+      ]
+    })
+    configs.push({
+      input: createProfileInput(),
+      output: {
+        file: path.join(dist, 'emnapi-core.profile.cjs.js'),
+        format: 'cjs',
+        exports: 'named',
+        strict: false
+      }
+    }, {
+      input: createProfileInput(),
+      output: {
+        file: path.join(dist, 'emnapi-core.profile.mjs'),
+        format: 'esm',
+        exports: 'named',
+        strict: false
+      }
+    })
+  }
+
+  return Promise.all(configs.map(conf => {
     return rollup.rollup(conf.input).then(bundle => bundle.write(conf.output))
   })).then(() => {
     const dts = path.join(__dirname, '../index.d.ts')
@@ -36,7 +36,7 @@ export class MessageHandler {
         })
       } else if (type === 'async-worker-init') {
         handleAfterLoad.call(this, e, () => {
-          this.napiModule.initWorker(payload.arg)
+          this.napiModule.initWorker(payload.arg, payload.channel)
         })
       } else if (type === 'async-work-execute') {
         handleAfterLoad.call(this, e, () => {
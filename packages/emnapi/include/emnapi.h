@@ -25,6 +25,27 @@ typedef enum {
   emnapi_buffer = -2,
 } emnapi_memory_view_type;
 
+typedef struct emnapi_prepared_call__* emnapi_prepared_call;
+
+typedef enum {
+  emnapi_prepared_args_double,
+  emnapi_prepared_args_int32,
+} emnapi_prepared_args_type;
+
+typedef struct {
+  // size of the linear memory
+  size_t memory_size;
+  // memory claimed by malloc
+  size_t heap_size;
+  // allocated blocks, including their headers
+  size_t used_size;
+  // free blocks, fragmentation is 1 - largest_free_size / free_size
+  size_t free_size;
+  size_t largest_free_size;
+  // whole 64KiB pages inside free blocks
+  size_t free_page_size;
+} emnapi_heap_statistics;
+
 EXTERN_C_START
 
 EMNAPI_EXTERN int emnapi_is_support_weakref();
@@ -76,6 +97,73 @@ napi_status emnapi_get_memory_address(napi_env env,
                                       emnapi_ownership* ownership,
                                       bool* runtime_allocated);
 
+// Like napi_create_buffer, but the memory is not zero filled,
+// as in Buffer.allocUnsafe().
+EMNAPI_EXTERN
+napi_status emnapi_create_buffer_unsafe(napi_env env,
+                                        size_t size,
+                                        void** data,
+                                        napi_value* result);
+
+// Returns the pooled block of a buffer created by napi_create_buffer or
+// emnapi_create_buffer_unsafe to the buffer pool without waiting for
+// the buffer to be garbage collected. The buffer must not be used
+// afterwards, its memory may be handed out to the next buffer. The
+// block is never given back to malloc. Blocks that are not pooled,
+// empty buffers and a second release return napi_invalid_arg.
+EMNAPI_EXTERN
+napi_status emnapi_release_buffer(napi_env env, napi_value buffer);
+
+// Like napi_define_properties, but the functions of methods with
+// napi_configurable are only created when the property is first read.
+// Until then such a property is an accessor. Other methods are created
+// right away. If `object` is frozen or sealed before the first read the
+// accessor stays in place and returns the same function every time.
+EMNAPI_EXTERN
+napi_status emnapi_define_lazy_properties(napi_env env,
+                                          napi_value object,
+                                          size_t property_count,
+                                          const napi_property_descriptor* properties);
+
+// A prepared call keeps the function referenced by `func` and `recv` alive
+// until it is released, and always passes `argc` arguments.
+EMNAPI_EXTERN
+napi_status emnapi_prepare_call(napi_env env,
+                                napi_ref func,
+                                napi_value recv,
+                                size_t argc,
+                                emnapi_prepared_call* result);
+
+// The argument area has room for `argc` doubles, or `argc` int32_t
+// packed from the start of it.
+EMNAPI_EXTERN
+napi_status emnapi_prepared_call_get_args(napi_env env,
+                                          emnapi_prepared_call call,
+                                          void** args);
+
+EMNAPI_EXTERN
+napi_status emnapi_call_prepared(napi_env env,
+                                 emnapi_prepared_call call,
+                                 const napi_value* argv,
+                                 napi_value* result);
+
+EMNAPI_EXTERN
+napi_status emnapi_call_prepared_args(napi_env env,
+                                      emnapi_prepared_call call,
+                                      emnapi_prepared_args_type type,
+                                      napi_value* result);
+
+EMNAPI_EXTERN
+napi_status emnapi_release_prepared_call(napi_env env,
+                                         emnapi_prepared_call call);
+
+// Wasm memory can not shrink. These describe how much of it malloc
+// could give back. Fields the allocator can not report are 0; only
+// the allocators built with emnapi report all of them.
+EMNAPI_EXTERN
+napi_status emnapi_get_heap_statistics(napi_env env,
+                                       emnapi_heap_statistics* result);
+
 EXTERN_C_END
 
 #endif
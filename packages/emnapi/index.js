@@ -14,6 +14,7 @@ const sources = [
   path.join(__dirname, './src/async_context.c'),
   path.join(__dirname, './src/async_work.c'),
   path.join(__dirname, './src/threadsafe_function.c'),
+  path.join(__dirname, './src/slab.c'),
   path.join(__dirname, './src/uv/uv-common.c'),
   path.join(__dirname, './src/uv/threadpool.c'),
   path.join(__dirname, './src/uv/unix/loop.c'),
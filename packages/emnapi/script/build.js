@@ -42,7 +42,16 @@ async function build () {
     'utf8'
   )
 
-  const coreTsconfigPath = path.join(__dirname, '../src/core/tsconfig.json')
+  buildCore('../src/core/tsconfig.json', 'module.js')
+  // EMNAPI_PROFILE=1 additionally builds a core with every napi_* / emnapi_*
+  // import wrapped by call counters and timers, next to the default one
+  if (process.env.EMNAPI_PROFILE) {
+    buildCore('../src/core/tsconfig.profile.json', 'module.profile.js')
+  }
+}
+
+function buildCore (tsconfig, outName) {
+  const coreTsconfigPath = path.join(__dirname, tsconfig)
   compile(coreTsconfigPath)
   const coreTsconfig = JSON.parse(fs.readFileSync(coreTsconfigPath, 'utf8'))
   const coreOut = path.join(path.dirname(coreTsconfigPath), coreTsconfig.compilerOptions.outFile)
@@ -58,7 +67,7 @@ async function build () {
     }
   })
   const parsedCode = compiler.parseCode(coreCode)
-  fs.writeFileSync(path.join(__dirname, '../../core/src/module.js'),
+  fs.writeFileSync(path.join(__dirname, '../../core/src', outName),
 `import { _WebAssembly as WebAssembly } from './util.js'
 
 export function createNapiModule (options) {
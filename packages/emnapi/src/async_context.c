@@ -24,11 +24,11 @@ napi_async_init(napi_env env,
   CHECK_ARG(env, async_resource_name);
   CHECK_ARG(env, result);
 
-  napi_async_context ret = (napi_async_context) malloc(sizeof(struct napi_async_context__));
+  napi_async_context ret = (napi_async_context) EMNAPI_SLAB_ALLOC(sizeof(struct napi_async_context__));
 
   napi_status status = _emnapi_async_init_js(async_resource, async_resource_name, ret);
   if (status != napi_ok) {
-    free(ret);
+    EMNAPI_SLAB_FREE(ret, sizeof(struct napi_async_context__));
     return napi_set_last_error(env, status, 0, NULL);
   }
 
@@ -45,7 +45,7 @@ napi_status napi_async_destroy(napi_env env,
   if (status != napi_ok) {
     return napi_set_last_error(env, status, 0, NULL);
   }
-  free(async_context);
+  EMNAPI_SLAB_FREE(async_context, sizeof(struct napi_async_context__));
 
   return napi_clear_last_error(env);
 }
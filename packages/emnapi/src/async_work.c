@@ -7,6 +7,10 @@
 #include <errno.h>
 #include "uv.h"
 
+#ifndef EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+#define EMNAPI_ASYNC_WORK_BATCH_COMPLETE 0
+#endif
+
 EXTERN_C_START
 
 struct napi_async_work__ {
@@ -16,6 +20,10 @@ struct napi_async_work__ {
   void* data;
   napi_async_execute_callback execute;
   napi_async_complete_callback complete;
+#if EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+  int status_;
+  napi_async_work next_completed_;
+#endif
 };
 
 static napi_async_work async_work_init(
@@ -26,7 +34,7 @@ static napi_async_work async_work_init(
   napi_async_complete_callback complete,
   void* data
 ) {
-  napi_async_work work = (napi_async_work)calloc(1, sizeof(struct napi_async_work__));
+  napi_async_work work = (napi_async_work)EMNAPI_SLAB_CALLOC(sizeof(struct napi_async_work__));
   if (work == NULL) return NULL;
   EMNAPI_ASYNC_RESOURCE_CTOR(env, async_resource, async_resource_name, (emnapi_async_resource*)work);
   work->env = env;
@@ -38,18 +46,13 @@ static napi_async_work async_work_init(
 
 static void async_work_delete(napi_async_work work) {
   EMNAPI_ASYNC_RESOURCE_DTOR(work->env, (emnapi_async_resource*)work);
-  free(work);
+  EMNAPI_SLAB_FREE(work, sizeof(struct napi_async_work__));
 }
 
 static void async_work_do_thread_pool_work(napi_async_work work) {
   work->execute(work->env, work->data);
 }
 
-typedef struct complete_wrap_s {
-  int status;
-  napi_async_work work;
-} complete_wrap_t;
-
 static napi_status convert_error_code(int code) {
   switch (code) {
     case 0:
@@ -63,11 +66,142 @@ static napi_status convert_error_code(int code) {
   }
 }
 
+static void async_work_schedule_work_on_execute(uv_work_t* req) {
+  napi_async_work self = container_of(req, struct napi_async_work__, work_req_);
+  async_work_do_thread_pool_work(self);
+}
+
+#if EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+
+// Completions are only touched on the main thread: they are appended by
+// uv__work_done and delivered by _emnapi_async_work_flush_completions
+// at the end of the same uv__work_done call.
+static napi_async_work completed_head = NULL;
+static napi_async_work completed_tail = NULL;
+// works queued and not yet completed, the runtime is kept alive
+// by one keepalive push for all of them
+static unsigned int scheduled_count = 0;
+static int keepalive_held = 0;
+
+static void async_work_on_complete_batch(napi_env env, void* args) {
+  napi_async_work work = (napi_async_work) args;
+  napi_async_work next;
+  bool pending;
+  napi_value err;
+  while (work != NULL) {
+    next = work->next_completed_;
+    // `complete` may delete the work
+    if (work->complete != NULL) {
+      work->complete(work->env, convert_error_code(work->status_), work->data);
+      // same as force_uncaught of _emnapi_callback_into_module,
+      // but the rest of the batch still runs
+      if (napi_is_exception_pending(env, &pending) == napi_ok && pending) {
+        EMNAPI_ASSERT_CALL(napi_get_and_clear_last_exception(env, &err));
+        napi_fatal_exception(env, err);
+      }
+    }
+    work = next;
+  }
+}
+
+static napi_value async_work_after_batch_cb(napi_env env, napi_callback_info info) {
+  void* data = NULL;
+  EMNAPI_ASSERT_CALL(napi_get_cb_info(env, info, NULL, NULL, NULL, &data));
+  _emnapi_callback_into_module(1, env, async_work_on_complete_batch, data, 1);
+  return NULL;
+}
+
+// runs completions of the same env in one handle scope and,
+// if the node binding is available, in one callback scope which
+// uses the async context of the first work in the batch
+static void async_work_after_thread_pool_work_batch(napi_async_work first) {
+  napi_handle_scope scope;
+  napi_value resource, cb;
+  napi_env env = first->env;
+  EMNAPI_ASSERT_CALL(napi_open_handle_scope(env, &scope));
+  if (emnapi_is_node_binding_available()) {
+    EMNAPI_ASSERT_CALL(napi_get_reference_value(env, first->resource_, &resource));
+    EMNAPI_ASSERT_CALL(napi_create_function(env, NULL, 0, async_work_after_batch_cb, first, &cb));
+    _emnapi_node_make_callback(env,
+                              resource,
+                              cb,
+                              NULL,
+                              0,
+                              first->async_context_.async_id,
+                              first->async_context_.trigger_async_id,
+                              NULL);
+  } else {
+    _emnapi_callback_into_module(1, env, async_work_on_complete_batch, first, 1);
+  }
+  EMNAPI_ASSERT_CALL(napi_close_handle_scope(env, scope));
+}
+
+void _emnapi_async_work_flush_completions(void) {
+  napi_async_work work = completed_head;
+  napi_async_work last;
+  unsigned int count;
+  completed_head = completed_tail = NULL;
+
+  while (work != NULL) {
+    // split the list into runs of the same env
+    count = 1;
+    last = work;
+    while (last->next_completed_ != NULL && last->next_completed_->env == work->env) {
+      last = last->next_completed_;
+      count++;
+    }
+    napi_async_work rest = last->next_completed_;
+    last->next_completed_ = NULL;
+    scheduled_count -= count;
+    async_work_after_thread_pool_work_batch(work);
+    work = rest;
+  }
+
+  if (scheduled_count == 0 && keepalive_held) {
+    keepalive_held = 0;
+    EMNAPI_KEEPALIVE_POP();
+    _emnapi_ctx_decrease_waiting_request_counter();
+  }
+}
+
+static void async_work_schedule_work_on_complete(uv_work_t* req, int status) {
+  napi_async_work self = container_of(req, struct napi_async_work__, work_req_);
+  self->status_ = status;
+  self->next_completed_ = NULL;
+  if (completed_tail == NULL) {
+    completed_head = self;
+  } else {
+    completed_tail->next_completed_ = self;
+  }
+  completed_tail = self;
+}
+
+static void async_work_schedule_work(napi_async_work work) {
+  if (!keepalive_held) {
+    keepalive_held = 1;
+    EMNAPI_KEEPALIVE_PUSH();
+    _emnapi_ctx_increase_waiting_request_counter();
+  }
+  scheduled_count++;
+  int status = uv_queue_work(uv_default_loop(),
+                             &work->work_req_,
+                             async_work_schedule_work_on_execute,
+                             async_work_schedule_work_on_complete);
+  CHECK_EQ(status, 0);
+}
+
+#else
+
+typedef struct complete_wrap_s {
+  int status;
+  napi_async_work work;
+} complete_wrap_t;
+
 static void async_work_on_complete(napi_env env, void* args) {
   complete_wrap_t* wrap = (complete_wrap_t*) args;
   napi_status status = convert_error_code(wrap->status);
   napi_async_work work = wrap->work;
-  free(wrap);
+  EMNAPI_SLAB_FREE(wrap, sizeof(complete_wrap_t));
   napi_env _env = work->env;
   void* data = work->data;
   work->complete(_env, status, data);
@@ -88,7 +222,7 @@ static void async_work_after_thread_pool_work(napi_async_work work, int status)
   napi_env env = work->env;
   EMNAPI_ASSERT_CALL(napi_open_handle_scope(env, &scope));
   EMNAPI_ASSERT_CALL(napi_get_reference_value(env, work->resource_, &resource));
-  complete_wrap_t* wrap = (complete_wrap_t*) malloc(sizeof(complete_wrap_t));
+  complete_wrap_t* wrap = (complete_wrap_t*) EMNAPI_SLAB_ALLOC(sizeof(complete_wrap_t));
   assert(wrap != NULL);
   wrap->status = status;
   wrap->work = work;
@@ -108,11 +242,6 @@ static void async_work_after_thread_pool_work(napi_async_work work, int status)
   EMNAPI_ASSERT_CALL(napi_close_handle_scope(env, scope));
 }
 
-static void async_work_schedule_work_on_execute(uv_work_t* req) {
-  napi_async_work self = container_of(req, struct napi_async_work__, work_req_);
-  async_work_do_thread_pool_work(self);
-}
-
 static void async_work_schedule_work_on_complete(uv_work_t* req, int status) {
   napi_async_work self = container_of(req, struct napi_async_work__, work_req_);
   EMNAPI_KEEPALIVE_POP();
@@ -130,6 +259,8 @@ static void async_work_schedule_work(napi_async_work work) {
   CHECK_EQ(status, 0);
 }
 
+#endif
+
 static int async_work_cancel_work(napi_async_work work) {
   return uv_cancel((uv_req_t*)&work->work_req_);
 }
@@ -1,8 +1,80 @@
+declare interface AsyncWorkDeque<T> {
+  items: Array<T | undefined>
+  head: number
+  size: number
+}
+
+// FIFO ring used for queued jobs and idle workers, shift is O(1)
+// unlike Array.prototype.shift
+var emnapiAWDeque = {
+  create<T> (): AsyncWorkDeque<T> {
+    // capacity is always a power of two
+    return { items: new Array(16), head: 0, size: 0 }
+  },
+  push<T> (deque: AsyncWorkDeque<T>, value: T): void {
+    let capacity = deque.items.length
+    if (deque.size === capacity) {
+      const items = new Array<T | undefined>(capacity << 1)
+      for (let i = 0; i < capacity; ++i) {
+        items[i] = deque.items[(deque.head + i) & (capacity - 1)]
+      }
+      deque.items = items
+      deque.head = 0
+      capacity <<= 1
+    }
+    deque.items[(deque.head + deque.size) & (capacity - 1)] = value
+    deque.size++
+  },
+  shift<T> (deque: AsyncWorkDeque<T>): T {
+    const value = deque.items[deque.head]!
+    deque.items[deque.head] = undefined
+    deque.head = (deque.head + 1) & (deque.items.length - 1)
+    deque.size--
+    return value
+  },
+  // O(n), only used by napi_cancel_async_work
+  remove<T> (deque: AsyncWorkDeque<T>, value: T): boolean {
+    const mask = deque.items.length - 1
+    for (let i = 0; i < deque.size; ++i) {
+      if (deque.items[(deque.head + i) & mask] === value) {
+        for (let j = i; j < deque.size - 1; ++j) {
+          deque.items[(deque.head + j) & mask] = deque.items[(deque.head + j + 1) & mask]
+        }
+        deque.items[(deque.head + deque.size - 1) & mask] = undefined
+        deque.size--
+        return true
+      }
+    }
+    return false
+  }
+}
+
 var emnapiAWMT = {
-  unusedWorkers: [] as any[],
-  runningWorkers: [] as any[],
-  workQueue: [] as number[],
+  unusedWorkers: emnapiAWDeque.create<any>(),
+  runningWorkers: new Set<any>(),
+  workQueue: emnapiAWDeque.create<number>(),
   workerReady: null as (Promise<any> & { ready: boolean }) | null,
+  // address of the dispatch channel in shared memory, 0 when jobs are
+  // sent to workers with postMessage
+  channel: 0,
+  channelCapacity: 0,
+  workerCount: 0,
+  inFlight: 0,
+  submitHead: 0,
+  completeTail: 0,
+  waiting: false,
+  // Int32 indices in the channel, the submit ring and the complete ring
+  // of `channelCapacity` work pointers each follow the header
+  channelIndex: {
+    submitHead: 0,
+    submitTail: 1,
+    completeReserve: 2,
+    completeCount: 3,
+    notifyPending: 4,
+    useMessage: 5,
+    mask: 6,
+    header: 8
+  },
   offset: {
     /* napi_ref */ resource: 0,
     /* double */ async_id: 8,
@@ -14,10 +86,17 @@ var emnapiAWMT = {
     end: 4 * $POINTER_SIZE + 24
   },
   init () {
-    emnapiAWMT.unusedWorkers = []
-    emnapiAWMT.runningWorkers = []
-    emnapiAWMT.workQueue = []
+    emnapiAWMT.unusedWorkers = emnapiAWDeque.create<any>()
+    emnapiAWMT.runningWorkers = new Set<any>()
+    emnapiAWMT.workQueue = emnapiAWDeque.create<number>()
     emnapiAWMT.workerReady = null
+    emnapiAWMT.channel = 0
+    emnapiAWMT.channelCapacity = 0
+    emnapiAWMT.workerCount = 0
+    emnapiAWMT.inFlight = 0
+    emnapiAWMT.submitHead = 0
+    emnapiAWMT.completeTail = 0
+    emnapiAWMT.waiting = false
   },
   addListener (worker: any) {
     if (!worker) return false
@@ -29,10 +108,17 @@ var emnapiAWMT = {
         const type = __emnapi__.type
         const payload = __emnapi__.payload
         if (type === 'async-work-complete') {
+          if (emnapiAWMT.channel) {
+            // coalesced notification, the finished jobs are in the channel
+            const i32 = new Int32Array(wasmMemory.buffer)
+            Atomics.store(i32, (emnapiAWMT.channel >>> 2) + emnapiAWMT.channelIndex.notifyPending, 0)
+            emnapiAWMT.drainCompletions()
+            return
+          }
           __emnapi_runtime_keepalive_pop()
           emnapiCtx.decreaseWaitingRequestCounter()
-          emnapiAWMT.runningWorkers.splice(emnapiAWMT.runningWorkers.indexOf(worker), 1)
-          emnapiAWMT.unusedWorkers.push(worker)
+          emnapiAWMT.runningWorkers.delete(worker)
+          emnapiAWDeque.push(emnapiAWMT.unusedWorkers, worker)
           emnapiAWMT.checkIdleWorker()
           emnapiAWMT.callComplete(payload.work, napi_status.napi_ok)
         } else if (type === 'async-work-queue') {
@@ -72,6 +158,7 @@ var emnapiAWMT = {
     for (let i = 0; i < n; ++i) {
       args.push((wasmInstance.exports as any).emnapi_async_worker_create())
     }
+    const channel = emnapiAWMT.createChannel(n)
     try {
       for (let i = 0; i < n; ++i) {
         const worker = onCreateWorker({ type: 'async-work' })
@@ -82,13 +169,13 @@ var emnapiAWMT = {
             worker.unref()
           }
         }))
-        emnapiAWMT.unusedWorkers.push(worker)
+        emnapiAWDeque.push(emnapiAWMT.unusedWorkers, worker)
         const arg = args[i]
         worker.threadBlockBase = arg
         worker.postMessage({
           __emnapi__: {
             type: 'async-worker-init',
-            payload: { arg }
+            payload: { arg, channel }
           }
         })
       }
@@ -98,16 +185,112 @@ var emnapiAWMT = {
         const arg = args[i]
         _free($to64('arg'))
       }
+      if (channel) {
+        _free($to64('channel'))
+        emnapiAWMT.channel = 0
+      }
       throw err
     }
     emnapiAWMT.workerReady = Promise.all(promises) as any
     return emnapiAWMT.workerReady as Promise<any>
   },
+  // Jobs go through the channel when the wasm memory is shared. Workers
+  // sleep in Atomics.wait on the submit head and take jobs from the
+  // submit ring, finished jobs are written to the complete ring. The main
+  // thread learns about them with Atomics.waitAsync, or with one message
+  // per batch where waitAsync is missing.
+  createChannel (n: number): number {
+    if ($POINTER_SIZE !== 4) return 0
+    if (typeof SharedArrayBuffer !== 'function' || !(wasmMemory.buffer instanceof SharedArrayBuffer)) return 0
+    let capacity = 1
+    while (capacity < n) capacity <<= 1
+    const index = emnapiAWMT.channelIndex
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const size = (index.header + 2 * capacity) * 4
+    let channel = _malloc($to64('size'))
+    if (!channel) return 0
+    $from64('channel')
+    channel = channel >>> 0
+    const i32 = new Int32Array(wasmMemory.buffer, channel, index.header + 2 * capacity)
+    i32.fill(0)
+    i32[index.useMessage] = typeof (Atomics as any).waitAsync === 'function' ? 0 : 1
+    i32[index.mask] = capacity - 1
+    emnapiAWMT.channel = channel
+    emnapiAWMT.channelCapacity = capacity
+    emnapiAWMT.workerCount = n
+    return channel
+  },
+  drainCompletions () {
+    const channel = emnapiAWMT.channel
+    const index = emnapiAWMT.channelIndex
+    const i32 = new Int32Array(wasmMemory.buffer)
+    const base = channel >>> 2
+    const ring = base + index.header + emnapiAWMT.channelCapacity
+    const mask = emnapiAWMT.channelCapacity - 1
+    const seen = Atomics.load(i32, base + index.completeCount)
+    const finished = [] as number[]
+    for (;;) {
+      const slot = ring + (emnapiAWMT.completeTail & mask)
+      const work = Atomics.load(i32, slot)
+      if (work === 0) break
+      Atomics.store(i32, slot, 0)
+      emnapiAWMT.completeTail = (emnapiAWMT.completeTail + 1) | 0
+      finished.push(work >>> 0)
+    }
+    emnapiAWMT.inFlight -= finished.length
+    emnapiAWMT.checkIdleWorker()
+    emnapiAWMT.waitCompletions(seen)
+    for (let i = 0; i < finished.length; ++i) {
+      __emnapi_runtime_keepalive_pop()
+      emnapiCtx.decreaseWaitingRequestCounter()
+      emnapiAWMT.callComplete(finished[i], napi_status.napi_ok)
+    }
+  },
+  waitCompletions (seen: number) {
+    if (emnapiAWMT.waiting || emnapiAWMT.inFlight === 0) return
+    const i32 = new Int32Array(wasmMemory.buffer)
+    const base = emnapiAWMT.channel >>> 2
+    if (i32[base + emnapiAWMT.channelIndex.useMessage]) return
+    emnapiAWMT.waiting = true
+    const result = (Atomics as any).waitAsync(i32, base + emnapiAWMT.channelIndex.completeCount, seen)
+    const drain = (): void => {
+      emnapiAWMT.waiting = false
+      emnapiAWMT.drainCompletions()
+    }
+    if (result.async) {
+      result.value.then(drain)
+    } else {
+      emnapiCtx.feature.setImmediate(drain)
+    }
+  },
   checkIdleWorker () {
-    if (emnapiAWMT.unusedWorkers.length > 0 && emnapiAWMT.workQueue.length > 0) {
-      const worker = emnapiAWMT.unusedWorkers.shift()!
-      const work = emnapiAWMT.workQueue.shift()!
-      emnapiAWMT.runningWorkers.push(worker)
+    if (emnapiAWMT.channel) {
+      const index = emnapiAWMT.channelIndex
+      const i32 = new Int32Array(wasmMemory.buffer)
+      const base = emnapiAWMT.channel >>> 2
+      const mask = emnapiAWMT.channelCapacity - 1
+      let pushed = 0
+      // at most one job per worker is in the channel, the rest stay in
+      // workQueue where napi_cancel_async_work can still find them
+      while (emnapiAWMT.workQueue.size > 0 && emnapiAWMT.inFlight < emnapiAWMT.workerCount) {
+        const work = emnapiAWDeque.shift(emnapiAWMT.workQueue)
+        Atomics.store(i32, base + index.header + (emnapiAWMT.submitHead & mask), work)
+        emnapiAWMT.submitHead = (emnapiAWMT.submitHead + 1) | 0
+        emnapiAWMT.inFlight++
+        pushed++
+      }
+      if (pushed > 0) {
+        Atomics.store(i32, base + index.submitHead, emnapiAWMT.submitHead)
+        Atomics.notify(i32, base + index.submitHead, pushed)
+        emnapiAWMT.waitCompletions(Atomics.load(i32, base + index.completeCount))
+      }
+      return
+    }
+    // give every idle worker a job in one pass
+    while (emnapiAWMT.unusedWorkers.size > 0 && emnapiAWMT.workQueue.size > 0) {
+      const worker = emnapiAWDeque.shift(emnapiAWMT.unusedWorkers)
+      const work = emnapiAWDeque.shift(emnapiAWMT.workQueue)
+      emnapiAWMT.runningWorkers.add(worker)
       worker.postMessage({
         __emnapi__: {
           type: 'async-work-execute',
@@ -144,7 +327,7 @@ var emnapiAWMT = {
     }
     __emnapi_runtime_keepalive_push()
     emnapiCtx.increaseWaitingRequestCounter()
-    emnapiAWMT.workQueue.push(work)
+    emnapiAWDeque.push(emnapiAWMT.workQueue, work)
     if (emnapiAWMT.workerReady?.ready) {
       emnapiAWMT.checkIdleWorker()
     } else {
@@ -174,9 +357,7 @@ var emnapiAWMT = {
       })
       return napi_status.napi_ok
     }
-    const index = emnapiAWMT.workQueue.indexOf(work)
-    if (index !== -1) {
-      emnapiAWMT.workQueue.splice(index, 1)
+    if (emnapiAWDeque.remove(emnapiAWMT.workQueue, work)) {
 
       emnapiCtx.feature.setImmediate(() => {
         __emnapi_runtime_keepalive_pop()
@@ -206,7 +387,7 @@ var emnapiAWMT = {
       if (emnapiNodeBinding) {
         const resource = emnapiAWMT.getResource(work)
         const resource_value = emnapiCtx.refStore.get(resource)!.get()
-        const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+        const resourceObject = emnapiCtx.handleStore.getValue(resource_value)
         const view = new DataView(wasmMemory.buffer)
         const asyncId = view.getFloat64(work + emnapiAWMT.offset.async_id, true)
         const triggerAsyncId = view.getFloat64(work + emnapiAWMT.offset.trigger_async_id, true)
@@ -232,14 +413,14 @@ var _napi_create_async_work = singleThreadAsyncWork
 
     let resourceObject: any
     if (resource) {
-      resourceObject = Object(emnapiCtx.handleStore.get(resource)!.value)
+      resourceObject = Object(emnapiCtx.handleStore.getValue(resource))
     } else {
       resourceObject = {}
     }
 
     $CHECK_ARG!(envObject, resource_name)
 
-    const resourceName = String(emnapiCtx.handleStore.get(resource_name)!.value)
+    const resourceName = String(emnapiCtx.handleStore.getValue(resource_name))
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
     const id = emnapiAWST.create(env, resourceObject, resourceName, execute, complete, data)
@@ -254,7 +435,7 @@ var _napi_create_async_work = singleThreadAsyncWork
 
     let resourceObject: any
     if (resource) {
-      resourceObject = Object(emnapiCtx.handleStore.get(resource)!.value)
+      resourceObject = Object(emnapiCtx.handleStore.getValue(resource))
     } else {
       resourceObject = {}
     }
@@ -346,16 +527,62 @@ var _napi_cancel_async_work = singleThreadAsyncWork
     return envObject.setLastError(status)
   }
 
-function initWorker (startArg: number): void {
+function initWorker (startArg: number, channel?: number): void {
   if (napiModule.childThread) {
     if (typeof wasmInstance.exports.emnapi_async_worker_init !== 'function') {
       throw new TypeError('emnapi_async_worker_init is not exported')
     }
     ;(wasmInstance.exports.emnapi_async_worker_init as Function)(startArg)
+    if (channel) runAsyncWorkLoop(channel)
   } else {
     throw new Error('startThread is only available in child threads')
   }
 }
+// Never returns, the worker only runs jobs taken from the channel
+// from now on.
+function runAsyncWorkLoop (channel: number): void {
+  const index = emnapiAWMT.channelIndex
+  const i32 = new Int32Array(wasmMemory.buffer)
+  const base = channel >>> 2
+  const mask = i32[base + index.mask]
+  const ring = base + index.header
+  const completeRing = ring + mask + 1
+  for (;;) {
+    const head = Atomics.load(i32, base + index.submitHead)
+    const tail = Atomics.load(i32, base + index.submitTail)
+    if (head === tail) {
+      Atomics.wait(i32, base + index.submitHead, head)
+      continue
+    }
+    // read the slot before claiming it, once submitTail moves past it
+    // the main thread may reuse the slot for a new job
+    const work = Atomics.load(i32, ring + (tail & mask)) >>> 0
+    if (Atomics.compareExchange(i32, base + index.submitTail, tail, (tail + 1) | 0) !== tail) continue
+
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const execute = emnapiAWMT.getExecute(work)
+    const env = emnapiAWMT.getEnv(work)
+    const data = emnapiAWMT.getData(work)
+    $makeDynCall('vpp', 'execute')(env, data)
+
+    const slot = Atomics.add(i32, base + index.completeReserve, 1)
+    Atomics.store(i32, completeRing + (slot & mask), work)
+    Atomics.add(i32, base + index.completeCount, 1)
+    if (i32[base + index.useMessage]) {
+      if (Atomics.compareExchange(i32, base + index.notifyPending, 0, 1) === 0) {
+        const postMessage = napiModule.postMessage!
+        postMessage({
+          __emnapi__: {
+            type: 'async-work-complete',
+            payload: {}
+          }
+        })
+      }
+    } else {
+      Atomics.notify(i32, base + index.completeCount, 1)
+    }
+  }
+}
 function executeAsyncWork (work: number): void {
   if (!ENVIRONMENT_IS_PTHREAD) return
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
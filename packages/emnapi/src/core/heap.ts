@@ -0,0 +1,56 @@
+/* eslint-disable @typescript-eslint/no-unused-vars */
+
+declare interface HeapUsage {
+  memorySize: number
+  // the fields below are 0 unless the module exports
+  // emnapi_get_heap_statistics
+  heapSize: number
+  usedSize: number
+  freeSize: number
+  largestFreeSize: number
+  freePageSize: number
+  fragmentation: number
+}
+
+// env of the loaded module, set by `napiModule.init`
+var emnapiHeapEnv = 0
+
+function emnapiCallHeapExport (name: string, size: number, read: (ptr: number) => void): boolean {
+  const f = wasmInstance?.exports[name]
+  if (typeof f !== 'function' || !emnapiHeapEnv) return false
+  const ptr = _malloc($to64('size'))
+  if (!ptr) return false
+  $from64('ptr')
+  try {
+    if ((f as Function)($to64('emnapiHeapEnv'), $to64('ptr')) !== napi_status.napi_ok) return false
+    read(ptr)
+    return true
+  } finally {
+    _free($to64('ptr'))
+  }
+}
+
+function emnapiGetHeapUsage (): HeapUsage {
+  const usage: HeapUsage = {
+    memorySize: wasmMemory.buffer.byteLength,
+    heapSize: 0,
+    usedSize: 0,
+    freeSize: 0,
+    largestFreeSize: 0,
+    freePageSize: 0,
+    fragmentation: 0
+  }
+  emnapiCallHeapExport('emnapi_get_heap_statistics', $POINTER_SIZE * 6, function (stats) {
+    usage.heapSize = $makeGetValue('stats', POINTER_SIZE, SIZE_TYPE) as number
+    usage.usedSize = $makeGetValue('stats', POINTER_SIZE * 2, SIZE_TYPE) as number
+    usage.freeSize = $makeGetValue('stats', POINTER_SIZE * 3, SIZE_TYPE) as number
+    usage.largestFreeSize = $makeGetValue('stats', POINTER_SIZE * 4, SIZE_TYPE) as number
+    usage.freePageSize = $makeGetValue('stats', POINTER_SIZE * 5, SIZE_TYPE) as number
+  })
+  if (usage.freeSize > 0 && usage.largestFreeSize > 0) {
+    usage.fragmentation = 1 - usage.largestFreeSize / usage.freeSize
+  }
+  return usage
+}
+
+emnapiImplementHelper('$emnapiGetHeapUsage', undefined, emnapiGetHeapUsage, undefined, 'getHeapUsage')
@@ -40,7 +40,7 @@ declare interface INapiModule {
   init (options: InitOptions): any
   spawnThread (startArg: number, errorOrTid?: number): number
   startThread (tid: number, startArg: number): void
-  initWorker (arg: number): void
+  initWorker (arg: number, channel?: number): void
   executeAsyncWork (work: number): void
   postMessage?: (msg: any) => any
 }
@@ -102,6 +102,8 @@ var napiModule: INapiModule = {
     wasmModule = module
     wasmMemory = memory
     wasmTable = table
+    // baseline for grow events
+    emnapiExternalMemory.checkMemoryGrowth()
     if (typeof exports.malloc !== 'function') throw new TypeError('malloc is not exported')
     if (typeof exports.free !== 'function') throw new TypeError('free is not exported')
     _malloc = exports.malloc
@@ -131,12 +133,13 @@ var napiModule: INapiModule = {
           const exportsHandle = scope.add(exports)
           const napi_register_wasm_v1 = instance.exports.napi_register_wasm_v1 as Function
           const napiValue = napi_register_wasm_v1($to64('_envObject.id'), $to64('exportsHandle.id'))
-          napiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.get(napiValue)!.value
+          napiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.getValue(napiValue)
         })
       } finally {
         emnapiCtx.closeScope(envObject, scope)
       }
       napiModule.loaded = true
+      emnapiHeapEnv = envObject.id
       delete napiModule.envObject
       return napiModule.exports
     }
@@ -0,0 +1,178 @@
+/* eslint-disable @typescript-eslint/no-unused-vars */
+
+declare interface ProfileEntry {
+  name: string
+  calls: number
+  pendingExceptions: number
+  totalTime: number
+  maxTime: number
+  samples: Float64Array
+  sampleCount: number
+}
+
+declare interface ProfileApiStat {
+  name: string
+  calls: number
+  totalTime: number
+  meanTime: number
+  maxTime: number
+  p99Time: number
+  pendingExceptions: number
+  pendingExceptionRate: number
+}
+
+declare interface ProfileSnapshot {
+  enabled: boolean
+  timeUnit: 'ms'
+  startTime: number
+  endTime: number
+  apis: ProfileApiStat[]
+}
+
+// Filled by `emnapiProfile.wrap`, which the transformer wraps around
+// every `emnapiImplement` / `emnapiImplement2` implementation when
+// `PROFILE` is defined. Without `PROFILE` nothing is wrapped and
+// the snapshot is always empty.
+const emnapiProfile = {
+  enabled: false,
+  // per-API latency samples kept for percentile estimation
+  sampleSize: 1024,
+  // most recent calls kept for trace-event output
+  traceSize: 65536,
+  startTime: 0,
+  entries: [] as ProfileEntry[],
+  traceEntry: undefined as Int32Array | undefined,
+  traceStart: undefined as Float64Array | undefined,
+  traceDuration: undefined as Float64Array | undefined,
+  traceCount: 0,
+
+  now: (typeof performance === 'object' && performance !== null && typeof performance.now === 'function')
+    ? function (): number { return performance.now() }
+    : function (): number { return Date.now() },
+
+  wrap: function<F extends Function> (name: string, f: F): F {
+    const index = emnapiProfile.entries.length
+    emnapiProfile.entries.push({
+      name,
+      calls: 0,
+      pendingExceptions: 0,
+      totalTime: 0,
+      maxTime: 0,
+      samples: new Float64Array(emnapiProfile.sampleSize),
+      sampleCount: 0
+    })
+    if (!emnapiProfile.enabled) {
+      emnapiProfile.enabled = true
+      emnapiProfile.traceEntry = new Int32Array(emnapiProfile.traceSize)
+      emnapiProfile.traceStart = new Float64Array(emnapiProfile.traceSize)
+      emnapiProfile.traceDuration = new Float64Array(emnapiProfile.traceSize)
+      emnapiProfile.startTime = emnapiProfile.now()
+    }
+    return function (this: any): any {
+      const start = emnapiProfile.now()
+      let ret: any
+      try {
+        ret = f.apply(this, arguments)
+      } finally {
+        emnapiProfile.record(index, start, emnapiProfile.now() - start, ret)
+      }
+      return ret
+    } as unknown as F
+  },
+
+  record: function (index: number, start: number, duration: number, ret: any): void {
+    const entry = emnapiProfile.entries[index]
+    entry.calls++
+    entry.totalTime += duration
+    if (duration > entry.maxTime) entry.maxTime = duration
+    if (ret === napi_status.napi_pending_exception) entry.pendingExceptions++
+    entry.samples[entry.sampleCount++ % entry.samples.length] = duration
+
+    const slot = emnapiProfile.traceCount++ % emnapiProfile.traceSize
+    emnapiProfile.traceEntry![slot] = index
+    emnapiProfile.traceStart![slot] = start
+    emnapiProfile.traceDuration![slot] = duration
+  },
+
+  percentile: function (entry: ProfileEntry, p: number): number {
+    const n = Math.min(entry.sampleCount, entry.samples.length)
+    if (n === 0) return 0
+    const sorted = Array.prototype.slice.call(entry.samples.subarray(0, n)).sort(function (a: number, b: number) { return a - b })
+    return sorted[Math.min(n - 1, Math.ceil(n * p) - 1)]
+  },
+
+  reset: function (): void {
+    const entries = emnapiProfile.entries
+    for (let i = 0; i < entries.length; ++i) {
+      const entry = entries[i]
+      entry.calls = 0
+      entry.pendingExceptions = 0
+      entry.totalTime = 0
+      entry.maxTime = 0
+      entry.sampleCount = 0
+    }
+    emnapiProfile.traceCount = 0
+    emnapiProfile.startTime = emnapiProfile.now()
+  }
+}
+
+function emnapiGetProfile (): ProfileSnapshot {
+  const apis: ProfileApiStat[] = []
+  const entries = emnapiProfile.entries
+  for (let i = 0; i < entries.length; ++i) {
+    const entry = entries[i]
+    if (entry.calls === 0) continue
+    apis.push({
+      name: entry.name,
+      calls: entry.calls,
+      totalTime: entry.totalTime,
+      meanTime: entry.totalTime / entry.calls,
+      maxTime: entry.maxTime,
+      p99Time: emnapiProfile.percentile(entry, 0.99),
+      pendingExceptions: entry.pendingExceptions,
+      pendingExceptionRate: entry.pendingExceptions / entry.calls
+    })
+  }
+  apis.sort(function (a, b) { return b.totalTime - a.totalTime })
+  return {
+    enabled: emnapiProfile.enabled,
+    timeUnit: 'ms',
+    startTime: emnapiProfile.startTime,
+    endTime: emnapiProfile.now(),
+    apis
+  }
+}
+
+function emnapiResetProfile (): void {
+  emnapiProfile.reset()
+}
+
+function emnapiDumpProfile (format?: 'json' | 'trace'): string {
+  if (format !== 'trace') {
+    return JSON.stringify(emnapiGetProfile())
+  }
+
+  // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+  const traceEvents: any[] = []
+  const total = emnapiProfile.traceCount
+  const size = emnapiProfile.traceSize
+  const first = total > size ? total - size : 0
+  const tid = ENVIRONMENT_IS_PTHREAD ? 2 : 1
+  for (let i = first; i < total; ++i) {
+    const slot = i % size
+    traceEvents.push({
+      name: emnapiProfile.entries[emnapiProfile.traceEntry![slot]].name,
+      cat: 'napi',
+      ph: 'X',
+      ts: emnapiProfile.traceStart![slot] * 1000,
+      dur: emnapiProfile.traceDuration![slot] * 1000,
+      pid: 1,
+      tid
+    })
+  }
+  return JSON.stringify({ traceEvents, displayTimeUnit: 'ms' })
+}
+
+emnapiImplementHelper('$emnapiGetProfile', undefined, emnapiGetProfile, undefined, 'getProfile')
+emnapiImplementHelper('$emnapiResetProfile', undefined, emnapiResetProfile, undefined, 'resetProfile')
+emnapiImplementHelper('$emnapiDumpProfile', undefined, emnapiDumpProfile, undefined, 'dumpProfile')
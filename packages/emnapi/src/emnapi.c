@@ -1,5 +1,11 @@
 #include "emnapi_internal.h"
 
+#ifdef __EMSCRIPTEN__
+#include <malloc.h>
+#else
+#include "malloc/heap_statistics.h"
+#endif
+
 EXTERN_C_START
 
 #ifdef __EMSCRIPTEN__
@@ -18,4 +24,38 @@ emnapi_get_emscripten_version(napi_env env,
 }
 #endif
 
+#ifndef __EMSCRIPTEN__
+// Defined by libdlmalloc, libemmalloc and libtlmalloc-mt,
+// null with any other malloc.
+__attribute__((weak))
+void _emnapi_malloc_get_statistics(emnapi_malloc_statistics* stats);
+#endif
+
+napi_status
+emnapi_get_heap_statistics(napi_env env,
+                           emnapi_heap_statistics* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  emnapi_heap_statistics stats = { 0, 0, 0, 0, 0, 0 };
+  *result = stats;
+  result->memory_size = __builtin_wasm_memory_size(0) * 65536;
+#ifdef __EMSCRIPTEN__
+  struct mallinfo info = mallinfo();
+  result->heap_size = info.arena;
+  result->used_size = info.uordblks;
+  result->free_size = info.fordblks;
+#else
+  if (_emnapi_malloc_get_statistics != NULL) {
+    emnapi_malloc_statistics malloc_stats = { 0, 0, 0, 0, 0 };
+    _emnapi_malloc_get_statistics(&malloc_stats);
+    result->heap_size = malloc_stats.heap_size;
+    result->used_size = malloc_stats.used_size;
+    result->free_size = malloc_stats.free_size;
+    result->largest_free_size = malloc_stats.largest_free_size;
+    result->free_page_size = malloc_stats.free_page_size;
+  }
+#endif
+  return napi_clear_last_error(env);
+}
+
 EXTERN_C_END
@@ -32,6 +32,7 @@ function _emnapi_create_memory_view (
       throw emnapiCtx.createNotSupportWeakRefError('emnapi_create_memory_view', 'Parameter "finalize_cb" must be 0(NULL)')
     }
 
+    emnapiExternalMemory.checkMemoryGrowth()
     let viewDescriptor: MemoryViewDescriptor
     switch (typedarray_type) {
       case emnapi_memory_view_type.emnapi_int8_array:
@@ -138,6 +139,7 @@ function emnapiSyncMemory<T extends ArrayBuffer | ArrayBufferView> (
     } else {
       wasmMemoryU8.set(view, pointer)
     }
+    emnapiExternalMemory.countCopy(emnapiExternalMemory.table.get(arrayBufferOrView), len)
 
     return arrayBufferOrView
   }
@@ -160,6 +162,7 @@ function emnapiSyncMemory<T extends ArrayBuffer | ArrayBufferView> (
     } else {
       wasmMemoryU8.set(view, pointer)
     }
+    emnapiExternalMemory.countCopy(emnapiExternalMemory.table.get(latestView.buffer as ArrayBuffer), len)
 
     return latestView
   }
@@ -216,6 +219,110 @@ function emnapiGetMemoryAddress (arrayBufferOrView: ArrayBuffer | ArrayBufferVie
   }
 }
 
+declare interface MemoryViewRef<T extends ArrayBufferView> {
+  readonly view: T
+  readonly address: number
+}
+
+function emnapiCreateMemoryViewRef<T extends ArrayBufferView> (view: T): MemoryViewRef<T> {
+  if (!ArrayBuffer.isView(view)) {
+    throw new TypeError('emnapiCreateMemoryViewRef expect ArrayBufferView as first parameter')
+  }
+  let current = emnapiExternalMemory.getOrUpdateMemoryView(view)
+  if (current.buffer !== wasmMemory.buffer) {
+    throw new TypeError('emnapiCreateMemoryViewRef expect a view of wasm memory')
+  }
+  const address = emnapiExternalMemory.wasmMemoryViewTable.get(current)!.address
+  return {
+    // re-bind lazily, the old view is detached or too short after memory.grow
+    get view (): T {
+      if (current.buffer !== wasmMemory.buffer) {
+        current = emnapiExternalMemory.getOrUpdateMemoryView(current)
+      }
+      return current
+    },
+    address
+  }
+}
+
+function emnapiOnMemoryGrow (listener: MemoryGrowListener): () => void {
+  if (typeof listener !== 'function') {
+    throw new TypeError('emnapiOnMemoryGrow expect function as first parameter')
+  }
+  emnapiExternalMemory.growListeners.push(listener)
+  return function () {
+    const index = emnapiExternalMemory.growListeners.indexOf(listener)
+    if (index !== -1) emnapiExternalMemory.growListeners.splice(index, 1)
+  }
+}
+
+declare interface ArrayBufferTracker {
+  markDirty (offset?: number, length?: number): void
+}
+
+declare interface MirrorStats {
+  copies: number
+  copiedBytes: number
+}
+
+function emnapiTrackArrayBuffer (arrayBufferOrView: ArrayBuffer | ArrayBufferView): ArrayBufferTracker {
+  let arrayBuffer: ArrayBuffer
+  let base: number
+  let byteLength: number
+  if (arrayBufferOrView instanceof ArrayBuffer) {
+    arrayBuffer = arrayBufferOrView
+    base = 0
+    byteLength = arrayBufferOrView.byteLength
+  } else if (ArrayBuffer.isView(arrayBufferOrView) && arrayBufferOrView.buffer instanceof ArrayBuffer) {
+    arrayBuffer = arrayBufferOrView.buffer
+    base = arrayBufferOrView.byteOffset
+    byteLength = arrayBufferOrView.byteLength
+  } else {
+    throw new TypeError('emnapiTrackArrayBuffer expect ArrayBuffer or ArrayBufferView as first parameter')
+  }
+  if (arrayBuffer === wasmMemory.buffer) {
+    throw new TypeError('wasm memory does not need to be tracked')
+  }
+
+  let dirty = emnapiExternalMemory.dirtyTable.get(arrayBuffer)
+  if (dirty === undefined) {
+    dirty = { start: 0, end: 0 }
+    emnapiExternalMemory.dirtyTable.set(arrayBuffer, dirty)
+  }
+  const range = dirty
+  return {
+    markDirty (offset?: number, length?: number): void {
+      offset = (offset ?? 0) >>> 0
+      length = (typeof length !== 'number' || length === -1) ? byteLength - offset : length >>> 0
+      if (length === 0) return
+      const start = base + offset
+      const end = Math.min(start + length, base + byteLength)
+      if (range.end <= range.start) {
+        range.start = start
+        range.end = end
+      } else {
+        if (start < range.start) range.start = start
+        if (end > range.end) range.end = end
+      }
+    }
+  }
+}
+
+function emnapiSetMirrorCopyOnce (enabled: boolean): void {
+  emnapiExternalMemory.copyOnce = Boolean(enabled)
+}
+
+function emnapiGetMirrorStats (arrayBufferOrView?: ArrayBuffer | ArrayBufferView): MirrorStats {
+  if (arrayBufferOrView === undefined) {
+    return { copies: emnapiExternalMemory.copies, copiedBytes: emnapiExternalMemory.copiedBytes }
+  }
+  const arrayBuffer = ArrayBuffer.isView(arrayBufferOrView) ? arrayBufferOrView.buffer as ArrayBuffer : arrayBufferOrView
+  const mirror = emnapiExternalMemory.table.get(arrayBuffer)
+  return mirror === undefined
+    ? { copies: 0, copiedBytes: 0 }
+    : { copies: mirror.copies, copiedBytes: mirror.copiedBytes }
+}
+
 function emnapi_get_memory_address (env: napi_env, arraybuffer_or_view: napi_value, address: Pointer<void_pp>, ownership: Pointer<int>, runtime_allocated: Pointer<bool>): napi_status {
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   let p: number, runtimeAllocated: number, ownershipOut: number
@@ -252,6 +359,11 @@ function emnapi_get_memory_address (env: napi_env, arraybuffer_or_view: napi_val
 
 emnapiImplementHelper('$emnapiSyncMemory', undefined, emnapiSyncMemory, ['$emnapiExternalMemory'], 'syncMemory')
 emnapiImplementHelper('$emnapiGetMemoryAddress', undefined, emnapiGetMemoryAddress, ['$emnapiExternalMemory'], 'getMemoryAddress')
+emnapiImplementHelper('$emnapiTrackArrayBuffer', undefined, emnapiTrackArrayBuffer, ['$emnapiExternalMemory'], 'trackArrayBuffer')
+emnapiImplementHelper('$emnapiSetMirrorCopyOnce', undefined, emnapiSetMirrorCopyOnce, ['$emnapiExternalMemory'], 'setMirrorCopyOnce')
+emnapiImplementHelper('$emnapiGetMirrorStats', undefined, emnapiGetMirrorStats, ['$emnapiExternalMemory'], 'getMirrorStats')
+emnapiImplementHelper('$emnapiCreateMemoryViewRef', undefined, emnapiCreateMemoryViewRef, ['$emnapiExternalMemory'], 'createMemoryViewRef')
+emnapiImplementHelper('$emnapiOnMemoryGrow', undefined, emnapiOnMemoryGrow, ['$emnapiExternalMemory'], 'onMemoryGrow')
 
 emnapiImplement2('emnapi_is_support_weakref', 'i', emnapi_is_support_weakref)
 emnapiImplement2('emnapi_is_support_bigint', 'i', emnapi_is_support_bigint)
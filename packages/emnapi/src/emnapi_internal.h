@@ -64,13 +64,41 @@ EXTERN_C_END
 #define CHECK_EQ(a, b) CHECK((a) == (b))
 #define CHECK_LE(a, b) CHECK((a) <= (b))
 
+// constant handle ids, keep in sync with GlobalHandle
+// in packages/runtime/src/typings/common.d.ts
+#define EMNAPI_HANDLE_UNDEFINED 1
+#define EMNAPI_HANDLE_NULL 2
+#define EMNAPI_HANDLE_FALSE 3
+#define EMNAPI_HANDLE_TRUE 4
+#define EMNAPI_HANDLE_GLOBAL 5
+
+// When EMNAPI_USE_IMMEDIATE_INTEGERS is set, integers in [-2^30, 2^30)
+// are encoded in the napi_value itself with bit 31 set. Handle ids never
+// reach bit 31, and the runtime decodes these values in HandleStore#get.
+#if defined(EMNAPI_USE_IMMEDIATE_INTEGERS) && EMNAPI_USE_IMMEDIATE_INTEGERS && !defined(__wasm64__)
+#define EMNAPI_HAVE_IMMEDIATE_INTEGERS 1
+#else
+#define EMNAPI_HAVE_IMMEDIATE_INTEGERS 0
+#endif
+
+#define EMNAPI_IMMEDIATE_TAG 0x80000000u
+#define EMNAPI_IMMEDIATE_MIN (-0x40000000)
+#define EMNAPI_IMMEDIATE_MAX 0x3fffffff
+
+#define EMNAPI_IS_IMMEDIATE(value) \
+  ((((uint32_t) (uintptr_t) (value)) & EMNAPI_IMMEDIATE_TAG) != 0)
+#define EMNAPI_TO_IMMEDIATE(i) \
+  ((napi_value) (uintptr_t) (((uint32_t) (i)) | EMNAPI_IMMEDIATE_TAG))
+#define EMNAPI_FROM_IMMEDIATE(value) \
+  (((int32_t) (((uint32_t) (uintptr_t) (value)) << 1)) >> 1)
+
 EXTERN_C_START
 
-EMNAPI_INTERNAL_EXTERN napi_status napi_set_last_error(napi_env env,
-                                       napi_status error_code,
-                                       uint32_t engine_error_code,
-                                       void* engine_reserved);
-EMNAPI_INTERNAL_EXTERN napi_status napi_clear_last_error(napi_env env);
+napi_status napi_set_last_error(napi_env env,
+                                napi_status error_code,
+                                uint32_t engine_error_code,
+                                void* engine_reserved);
+napi_status napi_clear_last_error(napi_env env);
 
 #ifdef __EMSCRIPTEN__
 #if __EMSCRIPTEN_major__ * 10000 + __EMSCRIPTEN_minor__ * 100 + __EMSCRIPTEN_tiny__ >= 30114  // NOLINT
@@ -103,6 +131,22 @@ EMNAPI_INTERNAL_EXTERN void _emnapi_ctx_decrease_waiting_request_counter();
 #define EMNAPI_HAVE_THREADS 0
 #endif
 
+// Small runtime objects go through the per-thread caches of slab.c,
+// `free` must be given the same size as `alloc`.
+#if EMNAPI_HAVE_THREADS
+void* _emnapi_slab_alloc(size_t size);
+void* _emnapi_slab_calloc(size_t size);
+void _emnapi_slab_free(void* p, size_t size);
+
+#define EMNAPI_SLAB_ALLOC(size) _emnapi_slab_alloc(size)
+#define EMNAPI_SLAB_CALLOC(size) _emnapi_slab_calloc(size)
+#define EMNAPI_SLAB_FREE(p, size) _emnapi_slab_free((p), (size))
+#else
+#define EMNAPI_SLAB_ALLOC(size) malloc(size)
+#define EMNAPI_SLAB_CALLOC(size) calloc(1, (size))
+#define EMNAPI_SLAB_FREE(p, size) free(p)
+#endif
+
 #if EMNAPI_HAVE_THREADS
 
 #define container_of(ptr, type, member) \
@@ -94,7 +94,7 @@ function emnapiInit (options: InitOptions): any {
       // eslint-disable-next-line @typescript-eslint/no-unused-vars
       const exportsHandle = scope.add(exports)
       const napiValue = _napi_register_wasm_v1($to64('_envObject.id'), $to64('exportsHandle.id'))
-      emnapiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.get(napiValue)!.value
+      emnapiModule.exports = (!napiValue) ? exports : emnapiCtx.handleStore.getValue(napiValue)
     })
   } catch (err) {
     emnapiCtx.closeScope(envObject, scope)
@@ -1,27 +1,67 @@
-function __emnapi_get_last_error_info (env: napi_env, error_code: Pointer<napi_status>, engine_error_code: Pointer<uint32_t>, engine_reserved: void_pp): void {
-  $from64('error_code')
-  $from64('engine_error_code')
-  $from64('engine_reserved')
-  const envObject = emnapiCtx.envStore.get(env)!
+// napi_extended_error_info of every env lives in wasm memory, so the C side
+// can clear the last error and return it from napi_get_last_error_info
+// without calling into JavaScript. Once the C side has asked for the
+// address, Env#setLastError and Env#clearLastError write it there only.
+const emnapiLastError = {
+  offset: {
+    /* const char* */ error_message: 0,
+    /* void* */ engine_reserved: 1 * $POINTER_SIZE,
+    /* uint32_t */ engine_error_code: 2 * $POINTER_SIZE,
+    /* napi_status */ error_code: 2 * $POINTER_SIZE + 4,
+    /* napi_extended_error_info */ end: 2 * $POINTER_SIZE + 8
+  },
+  // indexed by env id. The struct is not freed when the env is deleted:
+  // every thread caches the address in C keyed by the env id and that
+  // cache cannot be cleared from here, so the struct is kept and handed
+  // to the next env with the same id instead.
+  infos: [] as number[],
+
+  get: function (envObject: Env): number {
+    const id = envObject.id
+    if (envObject.syncLastError !== null) return emnapiLastError.infos[id]
+
+    const offset = emnapiLastError.offset
+    let info = emnapiLastError.infos[id]
+    if (info === undefined) {
+      // eslint-disable-next-line @typescript-eslint/no-unused-vars
+      const size = offset.end
+      info = _malloc($to64('size'))
+      if (!info) throw new Error('Out of memory')
+      $from64('info')
+      emnapiLastError.infos[id] = info
+    }
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const messagePtr = info + offset.error_message
+    const reservedPtr = info + offset.engine_reserved
+    const engineErrorCodePtr = info + offset.engine_error_code
+    const errorCodePtr = info + offset.error_code
+    $makeSetValue('messagePtr', 0, '0', '*')
+
+    const syncLastError = function (errorCode: napi_status, engineErrorCode: number, engineReserved: number): void {
+      $makeSetValue('errorCodePtr', 0, 'errorCode', 'i32')
+      $makeSetValue('engineErrorCodePtr', 0, 'engineErrorCode', 'u32')
+      $makeSetValue('reservedPtr', 0, 'engineReserved', '*')
+    }
+    const lastError = envObject.lastError
+    syncLastError(lastError.errorCode, lastError.engineErrorCode, lastError.engineReserved)
+    envObject.syncLastError = syncLastError
+    return info
+  }
+}
 
-  const lastError = envObject.lastError
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const errorCode = lastError.errorCode
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const engineErrorCode = lastError.engineErrorCode >>> 0
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  const engineReserved = lastError.engineReserved
-  $from64('engineReserved')
+emnapiDefineVar('$emnapiLastError', emnapiLastError, ['malloc'])
 
-  $makeSetValue('error_code', 0, 'errorCode', 'i32')
-  $makeSetValue('engine_error_code', 0, 'engineErrorCode', 'u32')
-  $makeSetValue('engine_reserved', 0, 'engineReserved', '*')
+function __emnapi_get_last_error_info (env: napi_env): void_p {
+  const envObject = emnapiCtx.envStore.get(env)!
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const info = emnapiLastError.get(envObject)
+  return $to64('info') as void_p
 }
 
 function napi_throw (env: napi_env, error: napi_value): napi_status {
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, error)
-    envObject.tryCatch.setError(emnapiCtx.handleStore.get(error)!.value)
+    envObject.tryCatch.setError(emnapiCtx.handleStore.getValue(error))
     return envObject.clearLastError()
   })
 }
@@ -98,14 +138,14 @@ function napi_create_error (env: napi_env, code: napi_value, msg: napi_value, re
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.getValue(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
 
   const error = new Error(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.getValue(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -125,13 +165,13 @@ function napi_create_type_error (env: napi_env, code: napi_value, msg: napi_valu
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.getValue(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new TypeError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.getValue(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -151,13 +191,13 @@ function napi_create_range_error (env: napi_env, code: napi_value, msg: napi_val
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.getValue(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new RangeError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.getValue(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -176,13 +216,13 @@ function node_api_create_syntax_error (env: napi_env, code: napi_value, msg: nap
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, msg)
   $CHECK_ARG!(envObject, result)
-  const msgValue = emnapiCtx.handleStore.get(msg)!.value
+  const msgValue = emnapiCtx.handleStore.getValue(msg)
   if (typeof msgValue !== 'string') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
   const error = new SyntaxError(msgValue)
   if (code) {
-    const codeValue = emnapiCtx.handleStore.get(code)!.value
+    const codeValue = emnapiCtx.handleStore.getValue(code)
     if (typeof codeValue !== 'string') {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
@@ -243,7 +283,7 @@ function napi_fatal_exception (env: napi_env, err: napi_value): napi_status {
   })
 }
 
-emnapiImplementInternal('_emnapi_get_last_error_info', 'vpppp', __emnapi_get_last_error_info)
+emnapiImplementInternal('_emnapi_get_last_error_info', 'pp', __emnapi_get_last_error_info, ['$emnapiLastError'])
 
 emnapiImplement('napi_get_and_clear_last_exception', 'ipp', napi_get_and_clear_last_exception)
 emnapiImplement('napi_throw', 'ipp', napi_throw)
@@ -66,6 +66,92 @@ function napi_get_cb_info (env: napi_env, _cbinfo: napi_callback_info, argc: Poi
   return envObject.clearLastError()
 }
 
+// Calls from C with up to 4 arguments are made directly, longer argument
+// lists are read into arrays taken from a pool so that repeated calls
+// do not allocate.
+const emnapiCall = {
+  pool: [] as any[][],
+  reflectConstruct: (typeof Reflect === 'object' && Reflect !== null && typeof Reflect.construct === 'function')
+    ? Reflect.construct
+    : undefined,
+
+  getArg: function (argv: number, i: number): any {
+    const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
+    return emnapiCtx.handleStore.getValue(argVal)
+  },
+
+  getDouble: function (args: number, i: number): number {
+    return $makeGetValue('args', 'i * 8', 'double')
+  },
+
+  getInt32: function (args: number, i: number): number {
+    return $makeGetValue('args', 'i * 4', 'i32')
+  },
+
+  readArgs: function (argc: number, argv: number, offset: number, getArg: (argv: number, i: number) => any): any[] {
+    const args = emnapiCall.pool.pop() || []
+    args.length = argc + offset
+    for (let i = 0; i < argc; i++) {
+      args[i + offset] = getArg(argv, i)
+    }
+    return args
+  },
+
+  releaseArgs: function (args: any[]): void {
+    // drop the references so that the pool does not keep values alive
+    args.length = 0
+    emnapiCall.pool.push(args)
+  },
+
+  call: function (f: Function, recv: any, argc: number, argv: number, getArg: (argv: number, i: number) => any): any {
+    switch (argc) {
+      case 0: return f.call(recv)
+      case 1: return f.call(recv, getArg(argv, 0))
+      case 2: return f.call(recv, getArg(argv, 0), getArg(argv, 1))
+      case 3: return f.call(recv, getArg(argv, 0), getArg(argv, 1), getArg(argv, 2))
+      case 4: return f.call(recv, getArg(argv, 0), getArg(argv, 1), getArg(argv, 2), getArg(argv, 3))
+      default: {
+        const args = emnapiCall.readArgs(argc, argv, 0, getArg)
+        try {
+          return f.apply(recv, args)
+        } finally {
+          emnapiCall.releaseArgs(args)
+        }
+      }
+    }
+  },
+
+  construct: function (Ctor: new (...args: any[]) => any, argc: number, argv: number, getArg: (argv: number, i: number) => any): any {
+    switch (argc) {
+      case 0: return new Ctor()
+      case 1: return new Ctor(getArg(argv, 0))
+      case 2: return new Ctor(getArg(argv, 0), getArg(argv, 1))
+      case 3: return new Ctor(getArg(argv, 0), getArg(argv, 1), getArg(argv, 2))
+      case 4: return new Ctor(getArg(argv, 0), getArg(argv, 1), getArg(argv, 2), getArg(argv, 3))
+      default: break
+    }
+    const reflectConstruct = emnapiCall.reflectConstruct
+    if (reflectConstruct !== undefined) {
+      const args = emnapiCall.readArgs(argc, argv, 0, getArg)
+      try {
+        return reflectConstruct(Ctor, args, Ctor)
+      } finally {
+        emnapiCall.releaseArgs(args)
+      }
+    }
+    const args = emnapiCall.readArgs(argc, argv, 1, getArg)
+    args[0] = undefined
+    try {
+      const BoundCtor = Ctor.bind.apply(Ctor, args as [undefined, ...any[]]) as new () => any
+      return new BoundCtor()
+    } finally {
+      emnapiCall.releaseArgs(args)
+    }
+  }
+}
+
+emnapiDefineVar('$emnapiCall', emnapiCall)
+
 function napi_call_function (
   env: napi_env,
   recv: napi_value,
@@ -74,7 +160,6 @@ function napi_call_function (
   argv: Const<Pointer<napi_value>>,
   result: Pointer<napi_value>
 ): napi_status {
-  let i = 0
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   let v: number
 
@@ -89,16 +174,11 @@ function napi_call_function (
     if (argc > 0) {
       if (!argv) return envObject.setLastError(napi_status.napi_invalid_arg)
     }
-    const v8recv = emnapiCtx.handleStore.get(recv)!.value
+    const v8recv = emnapiCtx.handleStore.getValue(recv)
     if (!func) return envObject.setLastError(napi_status.napi_invalid_arg)
-    const v8func = emnapiCtx.handleStore.get(func)!.value as Function
+    const v8func = emnapiCtx.handleStore.getValue(func) as Function
     if (typeof v8func !== 'function') return envObject.setLastError(napi_status.napi_invalid_arg)
-    const args = []
-    for (; i < argc; i++) {
-      const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-      args.push(emnapiCtx.handleStore.get(argVal)!.value)
-    }
-    const ret = v8func.apply(v8recv, args)
+    const ret = emnapiCall.call(v8func, v8recv, argc, argv, emnapiCall.getArg)
     if (result) {
       v = envObject.ensureHandleId(ret)
       $makeSetValue('result', 0, 'v', '*')
@@ -114,7 +194,6 @@ function napi_new_instance (
   argv: Pointer<napi_value>,
   result: Pointer<napi_value>
 ): napi_status {
-  let i: number
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   let v: number
 
@@ -130,26 +209,9 @@ function napi_new_instance (
     }
     if (!result) return envObject.setLastError(napi_status.napi_invalid_arg)
 
-    const Ctor: new (...args: any[]) => any = emnapiCtx.handleStore.get(constructor)!.value
+    const Ctor: new (...args: any[]) => any = emnapiCtx.handleStore.getValue(constructor)
     if (typeof Ctor !== 'function') return envObject.setLastError(napi_status.napi_invalid_arg)
-    let ret: any
-    if (emnapiCtx.feature.supportReflect) {
-      const argList = Array(argc)
-      for (i = 0; i < argc; i++) {
-        const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-        argList[i] = emnapiCtx.handleStore.get(argVal)!.value
-      }
-      ret = Reflect.construct(Ctor, argList, Ctor)
-    } else {
-      const args = Array(argc + 1) as [undefined, ...any[]]
-      args[0] = undefined
-      for (i = 0; i < argc; i++) {
-        const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-        args[i + 1] = emnapiCtx.handleStore.get(argVal)!.value
-      }
-      const BoundCtor = Ctor.bind.apply(Ctor, args) as new () => any
-      ret = new BoundCtor()
-    }
+    const ret = emnapiCall.construct(Ctor, argc, argv, emnapiCall.getArg)
     if (result) {
       v = envObject.ensureHandleId(ret)
       $makeSetValue('result', 0, 'v', '*')
@@ -177,8 +239,181 @@ function napi_get_new_target (
   return envObject.clearLastError()
 }
 
+declare interface PreparedCall {
+  func: Function
+  recv: any
+  argc: number
+  args: number
+}
+
+// Prepared calls resolve the function and the receiver once, calling one
+// only reads the arguments. Ids are indices into `calls`, 0 stays NULL.
+const emnapiPreparedCall = {
+  calls: [undefined] as Array<PreparedCall | undefined>,
+  freeIds: [] as number[],
+
+  add: function (call: PreparedCall): number {
+    const id = emnapiPreparedCall.freeIds.length > 0 ? emnapiPreparedCall.freeIds.pop()! : emnapiPreparedCall.calls.length
+    emnapiPreparedCall.calls[id] = call
+    return id
+  },
+
+  get: function (id: number): PreparedCall | undefined {
+    return id > 0 ? emnapiPreparedCall.calls[id] : undefined
+  },
+
+  remove: function (id: number): boolean {
+    const call = emnapiPreparedCall.get(id)
+    if (call === undefined) return false
+    const args = call.args
+    if (args) {
+      _free($to64('args') as number)
+    }
+    emnapiPreparedCall.calls[id] = undefined
+    emnapiPreparedCall.freeIds.push(id)
+    return true
+  }
+}
+
+emnapiDefineVar('$emnapiPreparedCall', emnapiPreparedCall, ['malloc', 'free'])
+
+function emnapi_prepare_call (
+  env: napi_env,
+  func: napi_ref,
+  recv: napi_value,
+  argc: size_t,
+  result: Pointer<emnapi_prepared_call>
+): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, func)
+  $CHECK_ARG!(envObject, recv)
+  $CHECK_ARG!(envObject, result)
+  $from64('argc')
+  $from64('result')
+
+  argc = argc >>> 0
+  const handleId = emnapiCtx.refStore.get(func)!.get()
+  if (!handleId) return envObject.setLastError(napi_status.napi_invalid_arg)
+  const f = emnapiCtx.handleStore.getValue(handleId)
+  if (typeof f !== 'function') return envObject.setLastError(napi_status.napi_function_expected)
+
+  let args = 0
+  if (argc > 0) {
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const size = argc * 8
+    args = _malloc($to64('size'))
+    if (!args) return envObject.setLastError(napi_status.napi_generic_failure)
+    $from64('args')
+  }
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const id = emnapiPreparedCall.add({
+    func: f,
+    recv: emnapiCtx.handleStore.getValue(recv),
+    argc,
+    args
+  })
+  $makeSetValue('result', 0, 'id', '*')
+  return envObject.clearLastError()
+}
+
+function emnapi_prepared_call_get_args (
+  env: napi_env,
+  call: emnapi_prepared_call,
+  args: Pointer<void_p>
+): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, call)
+  $CHECK_ARG!(envObject, args)
+  $from64('call')
+  $from64('args')
+
+  const preparedCall = emnapiPreparedCall.get(call)
+  if (preparedCall === undefined) return envObject.setLastError(napi_status.napi_invalid_arg)
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  const p = preparedCall.args
+  $makeSetValue('args', 0, 'p', '*')
+  return envObject.clearLastError()
+}
+
+function emnapi_call_prepared (
+  env: napi_env,
+  call: emnapi_prepared_call,
+  argv: Const<Pointer<napi_value>>,
+  result: Pointer<napi_value>
+): napi_status {
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  let v: number
+
+  return $PREAMBLE!(env, (envObject) => {
+    $CHECK_ARG!(envObject, call)
+    $from64('call')
+    $from64('argv')
+    $from64('result')
+
+    const preparedCall = emnapiPreparedCall.get(call)
+    if (preparedCall === undefined) return envObject.setLastError(napi_status.napi_invalid_arg)
+    if (preparedCall.argc > 0) {
+      if (!argv) return envObject.setLastError(napi_status.napi_invalid_arg)
+    }
+    const ret = emnapiCall.call(preparedCall.func, preparedCall.recv, preparedCall.argc, argv, emnapiCall.getArg)
+    if (result) {
+      v = envObject.ensureHandleId(ret)
+      $makeSetValue('result', 0, 'v', '*')
+    }
+    return envObject.clearLastError()
+  })
+}
+
+function emnapi_call_prepared_args (
+  env: napi_env,
+  call: emnapi_prepared_call,
+  type: emnapi_prepared_args_type,
+  result: Pointer<napi_value>
+): napi_status {
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  let v: number
+
+  return $PREAMBLE!(env, (envObject) => {
+    $CHECK_ARG!(envObject, call)
+    $from64('call')
+    $from64('result')
+
+    const preparedCall = emnapiPreparedCall.get(call)
+    if (preparedCall === undefined) return envObject.setLastError(napi_status.napi_invalid_arg)
+    let getArg: (args: number, i: number) => number
+    switch (type) {
+      case emnapi_prepared_args_type.emnapi_prepared_args_double: getArg = emnapiCall.getDouble; break
+      case emnapi_prepared_args_type.emnapi_prepared_args_int32: getArg = emnapiCall.getInt32; break
+      default: return envObject.setLastError(napi_status.napi_invalid_arg)
+    }
+    const ret = emnapiCall.call(preparedCall.func, preparedCall.recv, preparedCall.argc, preparedCall.args, getArg)
+    if (result) {
+      v = envObject.ensureHandleId(ret)
+      $makeSetValue('result', 0, 'v', '*')
+    }
+    return envObject.clearLastError()
+  })
+}
+
+function emnapi_release_prepared_call (env: napi_env, call: emnapi_prepared_call): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, call)
+  $from64('call')
+  if (!emnapiPreparedCall.remove(call)) return envObject.setLastError(napi_status.napi_invalid_arg)
+  return envObject.clearLastError()
+}
+
 emnapiImplement('napi_create_function', 'ipppppp', napi_create_function, ['$emnapiCreateFunction'])
 emnapiImplement('napi_get_cb_info', 'ipppppp', napi_get_cb_info)
-emnapiImplement('napi_call_function', 'ipppppp', napi_call_function)
-emnapiImplement('napi_new_instance', 'ippppp', napi_new_instance)
+emnapiImplement('napi_call_function', 'ipppppp', napi_call_function, ['$emnapiCall'])
+emnapiImplement('napi_new_instance', 'ippppp', napi_new_instance, ['$emnapiCall'])
 emnapiImplement('napi_get_new_target', 'ippp', napi_get_new_target)
+
+emnapiImplement2('emnapi_prepare_call', 'ippppp', emnapi_prepare_call, ['$emnapiPreparedCall'])
+emnapiImplement2('emnapi_prepared_call_get_args', 'ippp', emnapi_prepared_call_get_args, ['$emnapiPreparedCall'])
+emnapiImplement2('emnapi_call_prepared', 'ipppp', emnapi_call_prepared, ['$emnapiPreparedCall', '$emnapiCall'])
+emnapiImplement2('emnapi_call_prepared_args', 'ippip', emnapi_call_prepared_args, ['$emnapiPreparedCall', '$emnapiCall'])
+emnapiImplement2('emnapi_release_prepared_call', 'ipp', emnapi_release_prepared_call, ['$emnapiPreparedCall'])
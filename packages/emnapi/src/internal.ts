@@ -16,7 +16,7 @@ function emnapiCreateFunction<F extends (...args: any[]) => any> (envObject: Env
     try {
       return envObject.callIntoModule((envObject) => {
         const napiValue = $makeDynCall('ppp', 'cb')(envObject.id, 0)
-        return (!napiValue) ? undefined : emnapiCtx.handleStore.get(napiValue)!.value
+        return (!napiValue) ? undefined : emnapiCtx.handleStore.getValue(napiValue)
       })
     } finally {
       emnapiCtx.cbinfoStack.pop()
@@ -58,7 +58,41 @@ function emnapiCreateFunction<F extends (...args: any[]) => any> (envObject: Env
   return { status: napi_status.napi_ok, f }
 }
 
-function emnapiDefineProperty (envObject: Env, obj: object, propertyName: string | symbol, method: napi_callback, getter: napi_callback, setter: napi_callback, value: napi_value, attributes: number, data: void_p): void {
+// Property names given from C are mostly string literals, so decoded names
+// are cached by address. The address may have been reused for another
+// string, so a hit is checked against memory before it is returned.
+const emnapiPropertyName = {
+  maxSize: 4096,
+  cache: new Map<number, string>(),
+
+  get: function (HEAPU8: Uint8Array, ptr: number): string {
+    ptr >>>= 0
+    const cached = emnapiPropertyName.cache.get(ptr)
+    if (cached !== undefined) {
+      const len = cached.length
+      let i = 0
+      for (; i < len; ++i) {
+        if (HEAPU8[ptr + i] !== cached.charCodeAt(i)) break
+      }
+      if (i === len && HEAPU8[ptr + len] === 0) return cached
+    }
+    const name = emnapiString.UTF8ToString(ptr, -1)
+    // only ASCII names can be compared byte by byte
+    if (name.length <= 64 && /^[\x01-\x7f]*$/.test(name)) {
+      if (emnapiPropertyName.cache.size >= emnapiPropertyName.maxSize) {
+        emnapiPropertyName.cache.clear()
+      }
+      emnapiPropertyName.cache.set(ptr, name)
+    }
+    return name
+  }
+}
+
+emnapiDefineVar('$emnapiPropertyName', emnapiPropertyName, ['$emnapiString'])
+
+function emnapiCreatePropertyDescriptor (envObject: Env, obj: object, propertyName: string | symbol, method: napi_callback, getter: napi_callback, setter: napi_callback, value: napi_value, attributes: number, data: void_p, lazy: LazyMethod): PropertyDescriptor {
+  const configurable = (attributes & napi_property_attributes.napi_configurable) !== 0
+  const enumerable = (attributes & napi_property_attributes.napi_enumerable) !== 0
   if (getter || setter) {
     let localGetter: () => any
     let localSetter: (v: any) => void
@@ -68,31 +102,133 @@ function emnapiDefineProperty (envObject: Env, obj: object, propertyName: string
     if (setter) {
       localSetter = emnapiCreateFunction(envObject, 0, 0, setter, data).f
     }
-    const desc: PropertyDescriptor = {
-      configurable: (attributes & napi_property_attributes.napi_configurable) !== 0,
-      enumerable: (attributes & napi_property_attributes.napi_enumerable) !== 0,
+    return {
+      configurable,
+      enumerable,
       get: localGetter!,
       set: localSetter!
     }
-    Object.defineProperty(obj, propertyName, desc)
-  } else if (method) {
-    const localMethod = emnapiCreateFunction(envObject, 0, 0, method, data).f
-    const desc: PropertyDescriptor = {
-      configurable: (attributes & napi_property_attributes.napi_configurable) !== 0,
-      enumerable: (attributes & napi_property_attributes.napi_enumerable) !== 0,
-      writable: (attributes & napi_property_attributes.napi_writable) !== 0,
-      value: localMethod
-    }
-    Object.defineProperty(obj, propertyName, desc)
-  } else {
-    const desc: PropertyDescriptor = {
-      configurable: (attributes & napi_property_attributes.napi_configurable) !== 0,
-      enumerable: (attributes & napi_property_attributes.napi_enumerable) !== 0,
-      writable: (attributes & napi_property_attributes.napi_writable) !== 0,
-      value: emnapiCtx.handleStore.get(value)!.value
-    }
-    Object.defineProperty(obj, propertyName, desc)
   }
+  const writable = (attributes & napi_property_attributes.napi_writable) !== 0
+  if (method) {
+    // A lazy method starts as an accessor that replaces itself with the
+    // real method on first access, so modules with many methods only pay
+    // for the ones that are used. Only configurable methods are deferred,
+    // the accessor could not be replaced otherwise.
+    if (lazy === LazyMethod.Configurable && configurable) {
+      let localMethod: Function | undefined
+      const materialize = function (): boolean {
+        if (localMethod === undefined) {
+          localMethod = emnapiCreateFunction(envObject, 0, 0, method, data).f
+        }
+        // `obj` may have been frozen or sealed before the first access,
+        // keep returning the same function through the accessor then
+        const current = Object.getOwnPropertyDescriptor(obj, propertyName)
+        if (current === undefined || !current.configurable || current.get !== lazyGet) {
+          return false
+        }
+        Object.defineProperty(obj, propertyName, { configurable, enumerable, writable, value: localMethod })
+        return true
+      }
+      const lazyGet = function (): Function {
+        materialize()
+        return localMethod!
+      }
+      return {
+        configurable: true,
+        enumerable,
+        get: lazyGet,
+        set: writable
+          ? function (this: any, v: any): void {
+            if (!materialize()) {
+              throw new TypeError('Cannot assign to read only property \'' + String(propertyName) + '\' of object')
+            }
+            this[propertyName] = v
+          }
+          : undefined
+      }
+    }
+    return {
+      configurable,
+      enumerable,
+      writable,
+      value: emnapiCreateFunction(envObject, 0, 0, method, data).f
+    }
+  }
+  return {
+    configurable,
+    enumerable,
+    writable,
+    value: emnapiCtx.handleStore.getValue(value)
+  }
+}
+
+// Reads `property_count` napi_property_descriptor and defines them with one
+// Object.defineProperties call per target. Properties with napi_static go
+// to `staticObj` when it is given. A name that appears twice flushes the
+// pending descriptors first so the result matches defining one by one.
+function emnapiDefineProperties (envObject: Env, obj: object, staticObj: object | undefined, lazy: LazyMethod, property_count: number, properties: Const<Pointer<napi_property_descriptor>>): napi_status {
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  let propPtr: number, attributes: number
+
+  const HEAPU8 = new Uint8Array(wasmMemory.buffer)
+  let descs: PropertyDescriptorMap = Object.create(null)
+  let staticDescs: PropertyDescriptorMap = Object.create(null)
+  let hasDescs = false
+  let hasStaticDescs = false
+  const flush = function (): void {
+    if (hasDescs) {
+      Object.defineProperties(obj, descs)
+      descs = Object.create(null)
+      hasDescs = false
+    }
+    if (hasStaticDescs) {
+      Object.defineProperties(staticObj, staticDescs)
+      staticDescs = Object.create(null)
+      hasStaticDescs = false
+    }
+  }
+
+  let propertyName: string | symbol
+  for (let i = 0; i < property_count; i++) {
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    propPtr = properties + (i * ($POINTER_SIZE * 8))
+    const utf8Name = $makeGetValue('propPtr', 0, '*')
+    const name = $makeGetValue('propPtr', POINTER_SIZE, '*')
+    const method = $makeGetValue('propPtr', POINTER_SIZE * 2, '*')
+    const getter = $makeGetValue('propPtr', POINTER_SIZE * 3, '*')
+    const setter = $makeGetValue('propPtr', POINTER_SIZE * 4, '*')
+    const value = $makeGetValue('propPtr', POINTER_SIZE * 5, '*')
+    attributes = $makeGetValue('propPtr', POINTER_SIZE * 6, POINTER_WASM_TYPE) as number
+    $from64('attributes')
+    const data = $makeGetValue('propPtr', POINTER_SIZE * 7, '*')
+
+    if (utf8Name) {
+      propertyName = emnapiPropertyName.get(HEAPU8, utf8Name)
+    } else {
+      if (!name) {
+        flush()
+        return napi_status.napi_name_expected
+      }
+      propertyName = emnapiCtx.handleStore.getValue(name)
+      if (typeof propertyName !== 'string' && typeof propertyName !== 'symbol') {
+        flush()
+        return napi_status.napi_name_expected
+      }
+    }
+
+    if (staticObj !== undefined && (attributes & napi_property_attributes.napi_static) !== 0) {
+      if (propertyName in staticDescs) flush()
+      staticDescs[propertyName as any] = emnapiCreatePropertyDescriptor(envObject, staticObj, propertyName, method, getter, setter, value, attributes, data, lazy)
+      hasStaticDescs = true
+    } else {
+      if (propertyName in descs) flush()
+      descs[propertyName as any] = emnapiCreatePropertyDescriptor(envObject, obj, propertyName, method, getter, setter, value, attributes, data, lazy)
+      hasDescs = true
+    }
+  }
+  flush()
+  return napi_status.napi_ok
 }
 
 function emnapiGetHandle (js_object: napi_value): { status: napi_status; handle?: Handle<any> } {
@@ -187,7 +323,8 @@ function emnapiUnwrap (env: napi_env, js_object: napi_value, result: void_pp, ac
 }
 
 emnapiImplementHelper('$emnapiCreateFunction', undefined, emnapiCreateFunction, ['$emnapiString'])
-emnapiImplementHelper('$emnapiDefineProperty', undefined, emnapiDefineProperty, ['$emnapiCreateFunction'])
+emnapiImplementHelper('$emnapiCreatePropertyDescriptor', undefined, emnapiCreatePropertyDescriptor, ['$emnapiCreateFunction'])
+emnapiImplementHelper('$emnapiDefineProperties', undefined, emnapiDefineProperties, ['$emnapiCreatePropertyDescriptor', '$emnapiPropertyName'])
 emnapiImplementHelper('$emnapiGetHandle', undefined, emnapiGetHandle)
 emnapiImplementHelper('$emnapiWrap', undefined, emnapiWrap, ['$emnapiGetHandle'])
 emnapiImplementHelper('$emnapiUnwrap', undefined, emnapiUnwrap)
@@ -33,14 +33,50 @@ static const char* emnapi_error_messages[] = {
   "Cannot run JavaScript",
 };
 
-EMNAPI_INTERNAL_EXTERN void _emnapi_get_last_error_info(napi_env env,
-                                        napi_status* error_code,
-                                        uint32_t* engine_error_code,
-                                        void** engine_reserved);
+// Points to the napi_extended_error_info of the env in linear memory,
+// which the JavaScript side reads and writes as well.
+EMNAPI_INTERNAL_EXTERN
+napi_extended_error_info* _emnapi_get_last_error_info(napi_env env);
+
+#if EMNAPI_HAVE_THREADS
+#define EMNAPI_THREAD_LOCAL _Thread_local
+#else
+#define EMNAPI_THREAD_LOCAL
+#endif
+
+// A module normally has a single env, so one cached entry is enough.
+static EMNAPI_THREAD_LOCAL napi_env last_error_env = NULL;
+static EMNAPI_THREAD_LOCAL napi_extended_error_info* last_error_info = NULL;
+
+static napi_extended_error_info* emnapi_get_last_error(napi_env env) {
+  if (env != last_error_env) {
+    last_error_info = _emnapi_get_last_error_info(env);
+    last_error_env = env;
+  }
+  return last_error_info;
+}
+
+napi_status napi_set_last_error(napi_env env,
+                                napi_status error_code,
+                                uint32_t engine_error_code,
+                                void* engine_reserved) {
+  napi_extended_error_info* last_error = emnapi_get_last_error(env);
+  last_error->error_code = error_code;
+  last_error->engine_error_code = engine_error_code;
+  last_error->engine_reserved = engine_reserved;
+  return error_code;
+}
+
+napi_status napi_clear_last_error(napi_env env) {
+  napi_extended_error_info* last_error = emnapi_get_last_error(env);
+  last_error->error_code = napi_ok;
+  last_error->engine_error_code = 0;
+  last_error->engine_reserved = NULL;
+  return napi_ok;
+}
 
 napi_status napi_get_last_error_info(
     napi_env env, const napi_extended_error_info** result) {
-  static napi_extended_error_info last_error;
   CHECK_ENV(env);
   CHECK_ARG(env, result);
 
@@ -49,48 +85,247 @@ napi_status napi_get_last_error_info(
   static_assert((sizeof(emnapi_error_messages) / sizeof(const char*)) == napi_cannot_run_js + 1,
                 "Count of error messages must match count of error values");
 
-  _emnapi_get_last_error_info(env,
-                              &last_error.error_code,
-                              &last_error.engine_error_code,
-                              &last_error.engine_reserved);
+  napi_extended_error_info* last_error = emnapi_get_last_error(env);
 
-  CHECK_LE(last_error.error_code, last_status);
+  CHECK_LE(last_error->error_code, last_status);
 
-  last_error.error_message = emnapi_error_messages[last_error.error_code];
+  last_error->error_message = emnapi_error_messages[last_error->error_code];
 
-  if (last_error.error_code == napi_ok) {
-    napi_clear_last_error(env);
-    last_error.engine_error_code = 0;
-    last_error.engine_reserved = NULL;
+  if (last_error->error_code == napi_ok) {
+    last_error->engine_error_code = 0;
+    last_error->engine_reserved = NULL;
   }
-  *result = &last_error;
+  *result = last_error;
   return napi_ok;
 }
 
+// The values below live in fixed handle slots, so they are resolved here
+// instead of calling into JavaScript.
+
+napi_status napi_get_undefined(napi_env env, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  *result = (napi_value) (uintptr_t) EMNAPI_HANDLE_UNDEFINED;
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_get_null(napi_env env, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  *result = (napi_value) (uintptr_t) EMNAPI_HANDLE_NULL;
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_get_global(napi_env env, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  *result = (napi_value) (uintptr_t) EMNAPI_HANDLE_GLOBAL;
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  *result = (napi_value) (uintptr_t) (value ? EMNAPI_HANDLE_TRUE
+                                            : EMNAPI_HANDLE_FALSE);
+  return napi_clear_last_error(env);
+}
+
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_typeof(napi_env env,
+                                                  napi_value value,
+                                                  napi_valuetype* result);
+
+napi_status napi_typeof(napi_env env,
+                        napi_value value,
+                        napi_valuetype* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  switch ((uintptr_t) value) {
+    case EMNAPI_HANDLE_UNDEFINED:
+      *result = napi_undefined;
+      break;
+    case EMNAPI_HANDLE_NULL:
+      *result = napi_null;
+      break;
+    case EMNAPI_HANDLE_FALSE:
+    case EMNAPI_HANDLE_TRUE:
+      *result = napi_boolean;
+      break;
+    case EMNAPI_HANDLE_GLOBAL:
+      *result = napi_object;
+      break;
+    default:
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+      if (EMNAPI_IS_IMMEDIATE(value)) {
+        *result = napi_number;
+        break;
+      }
+#endif
+      return _emnapi_typeof(env, value, result);
+  }
+
+  return napi_clear_last_error(env);
+}
+
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_create_int32(napi_env env,
+                                                        int32_t value,
+                                                        napi_value* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_create_uint32(napi_env env,
+                                                         uint32_t value,
+                                                         napi_value* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_create_double(napi_env env,
+                                                         double value,
+                                                         napi_value* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_get_value_int32(napi_env env,
+                                                           napi_value value,
+                                                           int32_t* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_get_value_uint32(napi_env env,
+                                                            napi_value value,
+                                                            uint32_t* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_get_value_int64(napi_env env,
+                                                           napi_value value,
+                                                           int64_t* result);
+EMNAPI_INTERNAL_EXTERN napi_status _emnapi_get_value_double(napi_env env,
+                                                            napi_value value,
+                                                            double* result);
+
+// Numbers are created and read here so that small integers can skip
+// JavaScript entirely when EMNAPI_USE_IMMEDIATE_INTEGERS is enabled.
+// Everything else is forwarded to the JavaScript implementation.
+
+napi_status napi_create_int32(napi_env env,
+                              int32_t value,
+                              napi_value* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  if (value >= EMNAPI_IMMEDIATE_MIN && value <= EMNAPI_IMMEDIATE_MAX) {
+    *result = EMNAPI_TO_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_create_int32(env, value, result);
+}
+
+napi_status napi_create_uint32(napi_env env,
+                               uint32_t value,
+                               napi_value* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  if (value <= EMNAPI_IMMEDIATE_MAX) {
+    *result = EMNAPI_TO_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_create_uint32(env, value, result);
+}
+
+napi_status napi_create_double(napi_env env,
+                               double value,
+                               napi_value* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  // NaN fails both comparisons, -0 must stay a heap number
+  if (value >= EMNAPI_IMMEDIATE_MIN && value <= EMNAPI_IMMEDIATE_MAX &&
+      (double) (int32_t) value == value &&
+      !(value == 0 && __builtin_signbit(value))) {
+    *result = EMNAPI_TO_IMMEDIATE((int32_t) value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_create_double(env, value, result);
+}
+
+napi_status napi_get_value_int32(napi_env env,
+                                 napi_value value,
+                                 int32_t* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  if (EMNAPI_IS_IMMEDIATE(value)) {
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    *result = EMNAPI_FROM_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_get_value_int32(env, value, result);
+}
+
+napi_status napi_get_value_uint32(napi_env env,
+                                  napi_value value,
+                                  uint32_t* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  if (EMNAPI_IS_IMMEDIATE(value)) {
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    *result = (uint32_t) EMNAPI_FROM_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_get_value_uint32(env, value, result);
+}
+
+napi_status napi_get_value_int64(napi_env env,
+                                 napi_value value,
+                                 int64_t* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  if (EMNAPI_IS_IMMEDIATE(value)) {
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    *result = EMNAPI_FROM_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_get_value_int64(env, value, result);
+}
+
+napi_status napi_get_value_double(napi_env env,
+                                  napi_value value,
+                                  double* result) {
+#if EMNAPI_HAVE_IMMEDIATE_INTEGERS
+  if (EMNAPI_IS_IMMEDIATE(value)) {
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    *result = EMNAPI_FROM_IMMEDIATE(value);
+    return napi_clear_last_error(env);
+  }
+#endif
+  return _emnapi_get_value_double(env, value, result);
+}
+
 #define PAGESIZE 65536
 
+// Adds change_in_bytes to the external memory counter of the env,
+// which may drain finalizers or request a GC, see Env.adjustExternalMemory.
+EMNAPI_INTERNAL_EXTERN void _emnapi_adjust_external_memory(napi_env env, double change_in_bytes);
+
 napi_status napi_adjust_external_memory(napi_env env,
                                         int64_t change_in_bytes,
                                         int64_t* adjusted_value) {
   CHECK_ENV(env);
   CHECK_ARG(env, adjusted_value);
 
-  if (change_in_bytes < 0) {
-    return napi_set_last_error(env, napi_invalid_arg, 0, NULL);
-  }
-
-  size_t old_size = __builtin_wasm_memory_size(0) << 16;
-  size_t new_size = old_size + (size_t) change_in_bytes;
+  // make room for the reported memory in advance,
+  // releasing memory only needs to be accounted
+  if (change_in_bytes > 0) {
+    size_t old_size = __builtin_wasm_memory_size(0) << 16;
+    size_t new_size = old_size + (size_t) change_in_bytes;
 #ifdef __EMSCRIPTEN__
-  if (!emscripten_resize_heap(new_size)) {
-    return napi_set_last_error(env, napi_generic_failure, 0, NULL);
-  }
+    if (!emscripten_resize_heap(new_size)) {
+      return napi_set_last_error(env, napi_generic_failure, 0, NULL);
+    }
 #else
-  new_size = new_size + (PAGESIZE - new_size % PAGESIZE) % PAGESIZE;
-  if (-1 == __builtin_wasm_memory_grow(0, (new_size - old_size + 65535) >> 16)) {
-    return napi_set_last_error(env, napi_generic_failure, 0, NULL);
-  }
+    new_size = new_size + (PAGESIZE - new_size % PAGESIZE) % PAGESIZE;
+    if (-1 == __builtin_wasm_memory_grow(0, (new_size - old_size + 65535) >> 16)) {
+      return napi_set_last_error(env, napi_generic_failure, 0, NULL);
+    }
 #endif
+  }
+
+  _emnapi_adjust_external_memory(env, (double) change_in_bytes);
 
   *adjusted_value = (int64_t) (__builtin_wasm_memory_size(0) << 16);
 
@@ -90,3 +90,9 @@ void* aligned_alloc(size_t alignment, size_t bytes) {
 size_t malloc_usable_size(void *ptr) {
     return dlmalloc_usable_size(ptr);
 }
+
+#include "heap_statistics.h"
+
+void _emnapi_malloc_get_statistics(emnapi_malloc_statistics* stats) {
+    dl_get_statistics(gm, stats);
+}
@@ -0,0 +1,36 @@
+// Heap walk for emnapi_get_heap_statistics, included after malloc.c.
+
+#include "../heap_statistics.h"
+
+// the part of a free chunk that dlmalloc does not touch
+// while the chunk stays free
+#define DL_UNUSED_START(q) ((char*) (q) + sizeof(struct malloc_tree_chunk))
+
+static void dl_get_statistics(mstate m, emnapi_malloc_statistics* stats) {
+  ensure_initialization();
+  if (!PREACTION(m)) {
+    if (is_initialized(m)) {
+      size_t top_size = m->topsize + TOP_FOOT_SIZE;
+      stats->heap_size += m->footprint;
+      emnapi_malloc_count_free(stats, top_size,
+                               DL_UNUSED_START(m->top), (char*) m->top + m->topsize);
+      size_t free_size = top_size;
+      msegmentptr s = &m->seg;
+      while (s != 0) {
+        mchunkptr q = align_as_chunk(s->base);
+        while (segment_holds(s, q) &&
+               q != m->top && q->head != FENCEPOST_HEAD) {
+          size_t sz = chunksize(q);
+          if (!is_inuse(q)) {
+            free_size += sz;
+            emnapi_malloc_count_free(stats, sz, DL_UNUSED_START(q), (char*) q + sz);
+          }
+          q = next_chunk(q);
+        }
+        s = s->next;
+      }
+      stats->used_size += m->footprint - free_size;
+    }
+    POSTACTION(m);
+  }
+}
@@ -1549,3 +1549,44 @@ size_t emmalloc_unclaimed_heap_memory(void) {
   return emscripten_get_heap_max() - (size_t)sbrk(0);
 }
 #endif
+
+#include "../heap_statistics.h"
+
+// The prev/next pointers and the size fields are the only parts of
+// a free region emmalloc touches while the region stays free.
+static uint8_t *free_region_unused_start(Region *r)
+{
+  return (uint8_t*)r + offsetof(Region, _at_the_end_of_this_struct_size);
+}
+
+static uint8_t *free_region_unused_end(Region *r)
+{
+  return (uint8_t*)r + r->size - sizeof(size_t);
+}
+
+void _emnapi_malloc_get_statistics(emnapi_malloc_statistics *stats)
+{
+  MALLOC_ACQUIRE();
+  size_t heapSize = 0;
+  size_t freeSize = 0;
+  for(RootRegion *root = listOfAllRegions; root; root = root->next)
+  {
+    heapSize += root->endPtr - (uint8_t*)root;
+    Region *r = (Region*)root;
+    while((uint8_t*)r < root->endPtr)
+    {
+      if (region_is_free(r))
+      {
+        freeSize += r->size;
+        emnapi_malloc_count_free(stats, r->size,
+          (char*)free_region_unused_start(r), (char*)free_region_unused_end(r));
+      }
+      if (r->size == 0)
+        break;
+      r = next_region(r);
+    }
+  }
+  stats->heap_size += heapSize;
+  stats->used_size += heapSize - freeSize;
+  MALLOC_RELEASE();
+}
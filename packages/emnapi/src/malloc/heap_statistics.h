@@ -0,0 +1,37 @@
+#ifndef EMNAPI_MALLOC_HEAP_STATISTICS_H_
+#define EMNAPI_MALLOC_HEAP_STATISTICS_H_
+
+#include <stddef.h>
+
+// Implemented by the allocators in this directory and used by
+// emnapi_get_heap_statistics.
+// Sizes are in bytes.
+typedef struct emnapi_malloc_statistics {
+  // memory claimed from sbrk()
+  size_t heap_size;
+  // allocated blocks, including their headers
+  size_t used_size;
+  // free blocks
+  size_t free_size;
+  size_t largest_free_size;
+  // whole 64KiB pages inside free blocks
+  size_t free_page_size;
+} emnapi_malloc_statistics;
+
+#define EMNAPI_MALLOC_PAGE_SIZE 65536
+
+void _emnapi_malloc_get_statistics(emnapi_malloc_statistics* stats);
+
+static inline void emnapi_malloc_count_free(emnapi_malloc_statistics* stats,
+                                            size_t size,
+                                            char* unused_start,
+                                            char* unused_end) {
+  const size_t page = EMNAPI_MALLOC_PAGE_SIZE;
+  stats->free_size += size;
+  if (size > stats->largest_free_size) stats->largest_free_size = size;
+  char* start = (char*) (((size_t) unused_start + page - 1) & ~(page - 1));
+  char* end = (char*) ((size_t) unused_end & ~(page - 1));
+  if (end > start) stats->free_page_size += end - start;
+}
+
+#endif
@@ -12,13 +12,33 @@
 
 void *memcpy(void *restrict dest, const void *restrict src, size_t n)
 {
-#if defined(__wasm_bulk_memory__)
+#if defined(__wasm_bulk_memory__) && !defined(NO_BULK_MEMORY)
 	if (n > BULK_MEMORY_THRESHOLD)
 	  return __builtin_memcpy(dest, src, n);
 #endif
 	unsigned char *d = dest;
 	const unsigned char *s = src;
 
+#if defined(__wasm_simd128__) && !defined(NO_SIMD128)
+	if (n >= 16) {
+		typedef uint8_t __attribute__((__vector_size__(16), __aligned__(1), __may_alias__)) v128;
+
+		/* Copy the last 16 bytes first, so that the loops need no
+		 * tail handling. They may copy some of them again. */
+		*(v128 *)(d+n-16) = *(v128 *)(s+n-16);
+		for (; n>=64; s+=64, d+=64, n-=64) {
+			*(v128 *)(d+0) = *(v128 *)(s+0);
+			*(v128 *)(d+16) = *(v128 *)(s+16);
+			*(v128 *)(d+32) = *(v128 *)(s+32);
+			*(v128 *)(d+48) = *(v128 *)(s+48);
+		}
+		for (; n>=16; s+=16, d+=16, n-=16) {
+			*(v128 *)d = *(v128 *)s;
+		}
+		return dest;
+	}
+#endif
+
 #ifdef __GNUC__
 
 #if __BYTE_ORDER == __LITTLE_ENDIAN
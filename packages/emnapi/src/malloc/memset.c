@@ -7,13 +7,33 @@
 
 void *memset(void *dest, int c, size_t n)
 {
-#if defined(__wasm_bulk_memory__)
+#if defined(__wasm_bulk_memory__) && !defined(NO_BULK_MEMORY)
 	if (n > BULK_MEMORY_THRESHOLD)
 		return __builtin_memset(dest, c, n);
 #endif
 	unsigned char *s = dest;
 	size_t k;
 
+#if defined(__wasm_simd128__) && !defined(NO_SIMD128)
+	if (n >= 16) {
+		typedef uint8_t __attribute__((__vector_size__(16), __aligned__(1), __may_alias__)) v128;
+		v128 v = (v128){0} + (unsigned char)c;
+
+		/* Fill the last 16 bytes first, as in memcpy. */
+		*(v128 *)(s+n-16) = v;
+		for (; n>=64; n-=64, s+=64) {
+			*(v128 *)(s+0) = v;
+			*(v128 *)(s+16) = v;
+			*(v128 *)(s+32) = v;
+			*(v128 *)(s+48) = v;
+		}
+		for (; n>=16; n-=16, s+=16) {
+			*(v128 *)s = v;
+		}
+		return dest;
+	}
+#endif
+
 	/* Fill head and tail with minimal branching. Each
 	 * conditional ensures that all the subsequently used
 	 * offsets are well-defined and in the dest region. */
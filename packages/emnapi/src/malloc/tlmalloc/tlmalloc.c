@@ -0,0 +1,300 @@
+// Thread caching allocator for multithreaded wasm32.
+//
+// Small requests (up to 1024 bytes) are served from size-class bins.
+// Every thread keeps a free list per size class, so a malloc/free pair
+// on the same thread never takes a lock. Blocks move between threads
+// in batches through a central free list per size class, guarded by a
+// spin lock that is taken once per batch. A block freed by another
+// thread goes to the cache of the freeing thread, and overflowing
+// caches give whole batches back to the central list.
+//
+// Bins are carved from 64KiB pages taken directly from sbrk(), which
+// grows memory in whole wasm pages anyway. A page only ever holds
+// blocks of one size class and is never returned; the size class of
+// every page is recorded in a page map indexed by the page number, so
+// free() and malloc_usable_size() need no block header.
+//
+// Everything else, including alignments greater than 16, is forwarded
+// to dlmalloc with USE_LOCKS=1.
+
+#include <stddef.h>
+#include <stdint.h>
+
+void* sbrk(ptrdiff_t);
+void *memset(void *dst, int c, size_t n);
+void *memcpy(void *dst, const void* src, size_t n);
+
+// Define configuration macros for dlmalloc, see dlmalloc.c.
+
+#define HAVE_MMAP 0
+#define MORECORE_CANNOT_TRIM 1
+#define ABORT __builtin_unreachable()
+#define USE_LOCKS 1
+#define LACKS_TIME_H 1
+#define NO_MALLINFO 1
+#define NO_MALLOC_STATS 1
+#define MALLOC_ALIGNMENT 16
+
+extern const int __ENOMEM;
+#define ENOMEM __ENOMEM
+extern const int __EINVAL;
+#define EINVAL __EINVAL
+
+#define USE_DL_PREFIX 1
+#define DLMALLOC_EXPORT static inline
+
+static size_t dlmalloc_usable_size(void*);
+
+#include "../dlmalloc/malloc.c"
+
+#define TL_PAGE_SHIFT 16
+#define TL_PAGE_SIZE (1u << TL_PAGE_SHIFT)
+#define TL_PAGE_COUNT (1u << (32 - TL_PAGE_SHIFT))
+#define TL_CLASS_COUNT 20
+#define TL_MAX_SIZE 1024
+#define TL_ALIGNMENT 16
+
+typedef struct tl_block {
+  struct tl_block* next;
+  // only used by the first block of a batch in the central list
+  struct tl_block* next_batch;
+} tl_block;
+
+typedef struct tl_central {
+  volatile int lock;
+  tl_block* batches;
+  // unused tail of the most recent page of this size class
+  char* bump;
+  char* end;
+} tl_central;
+
+typedef struct tl_cache {
+  tl_block* head;
+  unsigned int count;
+} tl_cache;
+
+// size class + 1 of every 64KiB page, 0 for pages not owned by the bins
+static uint8_t tl_page_map[TL_PAGE_COUNT];
+static tl_central tl_centrals[TL_CLASS_COUNT];
+static volatile size_t tl_page_total = 0;
+static _Thread_local tl_cache tl_caches[TL_CLASS_COUNT];
+
+// 16 byte steps up to 128, then four classes per power of two
+static inline unsigned int tl_size_class(size_t size) {
+  if (size <= 128) return size == 0 ? 0 : (unsigned int) ((size + 15) >> 4) - 1;
+  unsigned int shift = 31 - __builtin_clz((unsigned int) (size - 1));
+  return 8 + (shift - 7) * 4 + (unsigned int) ((size - 1) >> (shift - 2)) - 4;
+}
+
+static inline size_t tl_class_size(unsigned int cls) {
+  if (cls < 8) return (cls + 1) * 16;
+  unsigned int g = (cls - 8) / 4;
+  unsigned int k = (cls - 8) % 4;
+  return ((size_t) 1 << (7 + g)) + (k + 1) * ((size_t) 1 << (5 + g));
+}
+
+// number of blocks moved between a thread and the central list at once
+static inline unsigned int tl_batch_size(unsigned int cls) {
+  size_t n = 4096 / tl_class_size(cls);
+  return n < 4 ? 4 : (n > 64 ? 64 : (unsigned int) n);
+}
+
+static inline void tl_lock(volatile int* lock) {
+  while (__sync_lock_test_and_set(lock, 1)) {
+    while (*lock) {}
+  }
+}
+
+static inline void tl_unlock(volatile int* lock) {
+  __sync_lock_release(lock);
+}
+
+static inline int tl_is_bin_block(void* ptr) {
+  return tl_page_map[(uintptr_t) ptr >> TL_PAGE_SHIFT] != 0;
+}
+
+static inline unsigned int tl_block_class(void* ptr) {
+  return tl_page_map[(uintptr_t) ptr >> TL_PAGE_SHIFT] - 1;
+}
+
+// takes a batch from the central list or carves one from a page,
+// called with the central lock held
+static tl_block* tl_central_take(tl_central* central, unsigned int cls, unsigned int* count) {
+  tl_block* batch = central->batches;
+  if (batch != NULL) {
+    central->batches = batch->next_batch;
+    unsigned int n = 0;
+    for (tl_block* b = batch; b != NULL; b = b->next) n++;
+    *count = n;
+    return batch;
+  }
+
+  size_t size = tl_class_size(cls);
+  if ((size_t) (central->end - central->bump) < size) {
+    char* page = (char*) sbrk(TL_PAGE_SIZE);
+    if (page == (char*) -1) return NULL;
+    // sbrk returns page aligned memory, since it only grows in whole pages
+    tl_page_map[(uintptr_t) page >> TL_PAGE_SHIFT] = (uint8_t) (cls + 1);
+    __sync_fetch_and_add(&tl_page_total, 1);
+    central->bump = page;
+    central->end = page + TL_PAGE_SIZE;
+  }
+
+  unsigned int want = tl_batch_size(cls);
+  size_t avail = (size_t) (central->end - central->bump) / size;
+  unsigned int n = avail < want ? (unsigned int) avail : want;
+  tl_block* head = (tl_block*) central->bump;
+  for (unsigned int i = 0; i < n - 1; ++i) {
+    ((tl_block*) (central->bump + i * size))->next = (tl_block*) (central->bump + (i + 1) * size);
+  }
+  ((tl_block*) (central->bump + (n - 1) * size))->next = NULL;
+  central->bump += n * size;
+  *count = n;
+  return head;
+}
+
+static void* tl_malloc_small(unsigned int cls) {
+  tl_cache* cache = tl_caches + cls;
+  tl_block* block = cache->head;
+  if (block == NULL) {
+    tl_central* central = tl_centrals + cls;
+    unsigned int count = 0;
+    tl_lock(&central->lock);
+    block = tl_central_take(central, cls, &count);
+    tl_unlock(&central->lock);
+    if (block == NULL) return NULL;
+    cache->count = count;
+  }
+  cache->head = block->next;
+  cache->count--;
+  return block;
+}
+
+static void tl_free_small(void* ptr) {
+  unsigned int cls = tl_block_class(ptr);
+  tl_cache* cache = tl_caches + cls;
+  tl_block* block = (tl_block*) ptr;
+  block->next = cache->head;
+  cache->head = block;
+  unsigned int batch_size = tl_batch_size(cls);
+  if (++cache->count < 2 * batch_size) return;
+
+  // keep one batch, give the other one back
+  tl_block* batch = cache->head;
+  tl_block* last = batch;
+  for (unsigned int i = 1; i < batch_size; ++i) last = last->next;
+  cache->head = last->next;
+  cache->count -= batch_size;
+  last->next = NULL;
+
+  tl_central* central = tl_centrals + cls;
+  tl_lock(&central->lock);
+  batch->next_batch = central->batches;
+  central->batches = batch;
+  tl_unlock(&central->lock);
+}
+
+static void* tl_malloc(size_t size) {
+  if (size <= TL_MAX_SIZE) {
+    void* ptr = tl_malloc_small(tl_size_class(size));
+    if (ptr != NULL) return ptr;
+  }
+  return dlmalloc(size);
+}
+
+static void tl_free(void* ptr) {
+  if (ptr == NULL) return;
+  if (tl_is_bin_block(ptr)) {
+    tl_free_small(ptr);
+  } else {
+    dlfree(ptr);
+  }
+}
+
+static size_t tl_usable_size(void* ptr) {
+  if (ptr == NULL) return 0;
+  if (tl_is_bin_block(ptr)) return tl_class_size(tl_block_class(ptr));
+  return dlmalloc_usable_size(ptr);
+}
+
+// Export the public names, the same ones as dlmalloc.c.
+
+void *malloc(size_t size) {
+  return tl_malloc(size);
+}
+
+void free(void *ptr) {
+  tl_free(ptr);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+  size_t bytes = nmemb * size;
+  if (size != 0 && bytes / size != nmemb) return NULL;
+  if (bytes > TL_MAX_SIZE) return dlcalloc(nmemb, size);
+  void* ptr = tl_malloc(bytes);
+  if (ptr != NULL) memset(ptr, 0, bytes);
+  return ptr;
+}
+
+void *realloc(void *ptr, size_t size) {
+  if (ptr == NULL) return tl_malloc(size);
+  if (!tl_is_bin_block(ptr)) {
+    if (size > TL_MAX_SIZE) return dlrealloc(ptr, size);
+  } else {
+    size_t old_size = tl_class_size(tl_block_class(ptr));
+    // shrinking by less than half keeps the block
+    if (size <= old_size && size > old_size / 2) return ptr;
+  }
+  size_t old_size = tl_usable_size(ptr);
+  void* new_ptr = tl_malloc(size);
+  if (new_ptr == NULL) return NULL;
+  memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+  tl_free(ptr);
+  return new_ptr;
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+  if (alignment <= TL_ALIGNMENT && size <= TL_MAX_SIZE &&
+      alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+      alignment % sizeof(void*) == 0) {
+    void* ptr = tl_malloc(size);
+    if (ptr == NULL) return ENOMEM;
+    *memptr = ptr;
+    return 0;
+  }
+  return dlposix_memalign(memptr, alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t bytes) {
+  if (alignment <= TL_ALIGNMENT && bytes <= TL_MAX_SIZE) {
+    return tl_malloc(bytes);
+  }
+  return dlmemalign(alignment, bytes);
+}
+
+size_t malloc_usable_size(void *ptr) {
+  return tl_usable_size(ptr);
+}
+
+#include "../dlmalloc/heap_statistics.h"
+
+// Blocks in thread caches are counted as used,
+// only the central lists can be walked safely.
+void _emnapi_malloc_get_statistics(emnapi_malloc_statistics* stats) {
+  dl_get_statistics(gm, stats);
+  size_t bin_size = tl_page_total * TL_PAGE_SIZE;
+  size_t free_size = 0;
+  for (unsigned int cls = 0; cls < TL_CLASS_COUNT; ++cls) {
+    tl_central* central = tl_centrals + cls;
+    size_t size = tl_class_size(cls);
+    tl_lock(&central->lock);
+    for (tl_block* batch = central->batches; batch != NULL; batch = batch->next_batch) {
+      for (tl_block* b = batch; b != NULL; b = b->next) free_size += size;
+    }
+    free_size += (size_t) (central->end - central->bump);
+    tl_unlock(&central->lock);
+  }
+  stats->heap_size += bin_size;
+  stats->used_size += bin_size - free_size;
+  stats->free_size += free_size;
+}
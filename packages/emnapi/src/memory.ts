@@ -19,33 +19,111 @@ declare interface ArrayBufferPointer {
   runtimeAllocated: 0 | 1
 }
 
+declare interface ArrayBufferMirror extends ArrayBufferPointer {
+  copies: number
+  copiedBytes: number
+}
+
+declare interface DirtyRange {
+  start: number
+  end: number
+}
+
 declare interface MemoryViewDescriptor extends ArrayBufferPointer {
   Ctor: ViewConstuctor
   length: number
+  /**
+   * Taken from emnapiBufferPool, returned there when released or collected.
+   * Released blocks get `address` and `length` 0, for every view sharing the descriptor.
+   */
+  pooled?: boolean
 }
 
 declare interface ViewPointer<T extends ArrayBufferView> extends ArrayBufferPointer {
   view: T
 }
 
+declare interface MemoryGrowEvent {
+  oldByteLength: number
+  newByteLength: number
+  generation: number
+}
+
+declare type MemoryGrowListener = (event: MemoryGrowEvent) => void
+
 const emnapiExternalMemory: {
   registry: FinalizationRegistry<number> | undefined
-  table: WeakMap<ArrayBuffer, ArrayBufferPointer>
+  table: WeakMap<ArrayBuffer, ArrayBufferMirror>
+  dirtyTable: WeakMap<ArrayBuffer, DirtyRange>
+  copyOnce: boolean
+  copies: number
+  copiedBytes: number
   wasmMemoryViewTable: WeakMap<ArrayBufferView, MemoryViewDescriptor>
+  lastBuffer: ArrayBufferLike | undefined
+  lastByteLength: number
+  generation: number
+  growListeners: MemoryGrowListener[]
   init: () => void
+  checkMemoryGrowth: () => boolean
   isDetachedArrayBuffer: (arrayBuffer: ArrayBufferLike) => boolean
+  countCopy: (mirror: ArrayBufferMirror | undefined, length: number) => void
+  copyToMirror: (arrayBuffer: ArrayBuffer, mirror: ArrayBufferMirror, offset: number, length: number) => void
+  refreshMirror: (arrayBuffer: ArrayBuffer, mirror: ArrayBufferMirror) => void
   getOrUpdateMemoryView: <T extends ArrayBufferView>(view: T) => T
   getArrayBufferPointer: (arrayBuffer: ArrayBuffer, shouldCopy: boolean) => ArrayBufferPointer
   getViewPointer: <T extends ArrayBufferView>(view: T, shouldCopy: boolean) => ViewPointer<T>
 } = {
   registry: typeof FinalizationRegistry === 'function' ? new FinalizationRegistry(function (_pointer) { _free($to64('_pointer') as number) }) : undefined,
   table: new WeakMap(),
+  dirtyTable: new WeakMap(),
+  copyOnce: false,
+  copies: 0,
+  copiedBytes: 0,
   wasmMemoryViewTable: new WeakMap(),
+  lastBuffer: undefined,
+  lastByteLength: 0,
+  generation: 0,
+  growListeners: [],
 
   init: function () {
     emnapiExternalMemory.registry = typeof FinalizationRegistry === 'function' ? new FinalizationRegistry(function (_pointer) { _free($to64('_pointer') as number) }) : undefined
     emnapiExternalMemory.table = new WeakMap()
+    emnapiExternalMemory.dirtyTable = new WeakMap()
+    emnapiExternalMemory.copyOnce = false
+    emnapiExternalMemory.copies = 0
+    emnapiExternalMemory.copiedBytes = 0
     emnapiExternalMemory.wasmMemoryViewTable = new WeakMap()
+    emnapiExternalMemory.lastBuffer = undefined
+    emnapiExternalMemory.lastByteLength = 0
+    emnapiExternalMemory.generation = 0
+    emnapiExternalMemory.growListeners = []
+  },
+
+  // Called where growth actually happens: emscripten's updateMemoryViews
+  // (see the postset below) and napi_adjust_external_memory. memory.grow
+  // done by a bare wasm32 or wasi malloc does not notify JS, that growth
+  // is found the next time a memory view is looked up.
+  checkMemoryGrowth: function (): boolean {
+    const buffer = wasmMemory.buffer
+    if (buffer === emnapiExternalMemory.lastBuffer) return false
+    const oldByteLength = emnapiExternalMemory.lastByteLength
+    const newByteLength = buffer.byteLength
+    const initialized = emnapiExternalMemory.lastBuffer !== undefined
+    emnapiExternalMemory.lastBuffer = buffer
+    emnapiExternalMemory.lastByteLength = newByteLength
+    if (!initialized || newByteLength === oldByteLength) return false
+
+    const generation = ++emnapiExternalMemory.generation
+    const listeners = emnapiExternalMemory.growListeners.slice()
+    const event: MemoryGrowEvent = {
+      oldByteLength,
+      newByteLength,
+      generation
+    }
+    for (let i = 0; i < listeners.length; ++i) {
+      listeners[i](event)
+    }
+    return true
   },
 
   isDetachedArrayBuffer: function (arrayBuffer: ArrayBufferLike): boolean {
@@ -60,6 +138,37 @@ const emnapiExternalMemory: {
     return false
   },
 
+  countCopy: function (mirror: ArrayBufferMirror | undefined, length: number): void {
+    if (mirror !== undefined) {
+      mirror.copies++
+      mirror.copiedBytes += length
+    }
+    emnapiExternalMemory.copies++
+    emnapiExternalMemory.copiedBytes += length
+  },
+
+  copyToMirror: function (arrayBuffer: ArrayBuffer, mirror: ArrayBufferMirror, offset: number, length: number): void {
+    new Uint8Array(wasmMemory.buffer).set(new Uint8Array(arrayBuffer, offset, length), mirror.address + offset)
+    emnapiExternalMemory.countCopy(mirror, length)
+  },
+
+  // Bring an existing mirror up to date before native code reads it.
+  // Tracked buffers only copy what was marked dirty since the last refresh,
+  // otherwise the whole buffer is copied unless copy-once mode is enabled.
+  refreshMirror: function (arrayBuffer: ArrayBuffer, mirror: ArrayBufferMirror): void {
+    const dirty = emnapiExternalMemory.dirtyTable.get(arrayBuffer)
+    if (dirty !== undefined) {
+      const end = Math.min(dirty.end, arrayBuffer.byteLength)
+      if (end > dirty.start) {
+        emnapiExternalMemory.copyToMirror(arrayBuffer, mirror, dirty.start, end - dirty.start)
+      }
+      dirty.start = dirty.end = 0
+      return
+    }
+    if (emnapiExternalMemory.copyOnce) return
+    emnapiExternalMemory.copyToMirror(arrayBuffer, mirror, 0, arrayBuffer.byteLength)
+  },
+
   getArrayBufferPointer: function (arrayBuffer: ArrayBuffer, shouldCopy: boolean): ArrayBufferPointer {
     const info: ArrayBufferPointer = {
       address: 0,
@@ -78,7 +187,7 @@ const emnapiExternalMemory: {
         return cachedInfo
       }
       if (shouldCopy && cachedInfo.ownership === Ownership.kRuntime && cachedInfo.runtimeAllocated === 1) {
-        new Uint8Array(wasmMemory.buffer).set(new Uint8Array(arrayBuffer), cachedInfo.address)
+        emnapiExternalMemory.refreshMirror(arrayBuffer, cachedInfo)
       }
       return cachedInfo
     }
@@ -93,24 +202,33 @@ const emnapiExternalMemory: {
 
     const pointer = _malloc($to64('arrayBuffer.byteLength'))
     if (!pointer) throw new Error('Out of memory')
-    new Uint8Array(wasmMemory.buffer).set(new Uint8Array(arrayBuffer), pointer)
 
-    info.address = pointer
-    info.ownership = emnapiExternalMemory.registry ? Ownership.kRuntime : Ownership.kUserland
-    info.runtimeAllocated = 1
+    const mirror: ArrayBufferMirror = {
+      address: pointer,
+      ownership: emnapiExternalMemory.registry ? Ownership.kRuntime : Ownership.kUserland,
+      runtimeAllocated: 1,
+      copies: 0,
+      copiedBytes: 0
+    }
+    emnapiExternalMemory.copyToMirror(arrayBuffer, mirror, 0, arrayBuffer.byteLength)
+    const dirty = emnapiExternalMemory.dirtyTable.get(arrayBuffer)
+    if (dirty !== undefined) {
+      dirty.start = dirty.end = 0
+    }
 
-    emnapiExternalMemory.table.set(arrayBuffer, info)
+    emnapiExternalMemory.table.set(arrayBuffer, mirror)
     emnapiExternalMemory.registry?.register(arrayBuffer, pointer)
-    return info
+    return mirror
   },
 
   getOrUpdateMemoryView: function<T extends ArrayBufferView> (view: T): T {
+    emnapiExternalMemory.checkMemoryGrowth()
     if (view.buffer === wasmMemory.buffer) {
       if (!emnapiExternalMemory.wasmMemoryViewTable.has(view)) {
         emnapiExternalMemory.wasmMemoryViewTable.set(view, {
           Ctor: view.constructor as any,
           address: view.byteOffset,
-          length: view instanceof DataView ? view.byteLength : (view as any).length,
+          length: emnapiCtx.feature.getTypedArrayType(view) === -1 ? view.byteLength : (view as any).length,
           ownership: Ownership.kUserland,
           runtimeAllocated: 0
         })
@@ -156,5 +274,87 @@ emnapiDefineVar(
   '$emnapiExternalMemory',
   emnapiExternalMemory,
   ['malloc', 'free', '$emnapiInit'],
-  'emnapiExternalMemory.init();'
+  // a single string literal, the core transformer turns it into a function
+  'emnapiExternalMemory.init(); if (typeof updateMemoryViews === "function") { var __original_updateMemoryViews = updateMemoryViews; updateMemoryViews = function () { var r = __original_updateMemoryViews.apply(this, arguments); emnapiExternalMemory.checkMemoryGrowth(); return r; }; }'
+)
+
+// Size-classed free lists of the malloc'd blocks behind napi_create_buffer,
+// so that short-lived buffers reuse blocks instead of going through
+// malloc / free every time. Blocks come back when a buffer is released
+// with emnapi_release_buffer or collected. Requires FinalizationRegistry,
+// without it buffers are not pooled.
+const emnapiBufferPool = {
+  MIN_SHIFT: 6,
+  MAX_SHIFT: 16,
+  MAX_POOLED_BYTES: 4 * 1024 * 1024,
+  freeLists: [] as number[][],
+  pooledBytes: 0,
+  // keyed on the MemoryViewDescriptor, which lives as long as any view
+  // of the block, the held value is [address, size]
+  registry: undefined as FinalizationRegistry<[number, number]> | undefined,
+  // Blocks given back by emnapi_release_buffer may still be written
+  // through the released buffer, so they stay in the pool for good, even
+  // over MAX_POOLED_BYTES. A stale write then only reaches another
+  // buffer's data, never malloc's chunk headers.
+  pinned: new Set<number>(),
+
+  init: function () {
+    emnapiBufferPool.freeLists = []
+    for (let i = emnapiBufferPool.MIN_SHIFT; i <= emnapiBufferPool.MAX_SHIFT; ++i) {
+      emnapiBufferPool.freeLists.push([])
+    }
+    emnapiBufferPool.pooledBytes = 0
+    emnapiBufferPool.pinned = new Set()
+    emnapiBufferPool.registry = typeof FinalizationRegistry === 'function'
+      ? new FinalizationRegistry(function (block: [number, number]) { emnapiBufferPool.release(block[0], block[1]) })
+      : undefined
+  },
+
+  /** -1 if blocks of `size` bytes are not pooled */
+  sizeClass: function (size: number): number {
+    if (size > (1 << emnapiBufferPool.MAX_SHIFT)) return -1
+    const shift = size <= (1 << emnapiBufferPool.MIN_SHIFT) ? emnapiBufferPool.MIN_SHIFT : (32 - Math.clz32(size - 1))
+    return shift - emnapiBufferPool.MIN_SHIFT
+  },
+
+  acquire: function (size: number): number {
+    const cls = emnapiBufferPool.sizeClass(size)
+    const blockSize = 1 << (cls + emnapiBufferPool.MIN_SHIFT)
+    const list = emnapiBufferPool.freeLists[cls]
+    if (list.length > 0) {
+      emnapiBufferPool.pooledBytes -= blockSize
+      return list.pop()!
+    }
+    return _malloc($to64('blockSize'))
+  },
+
+  /** `false` if the pool is full and `force` is not set */
+  put: function (pointer: number, size: number, force: boolean): boolean {
+    const cls = emnapiBufferPool.sizeClass(size)
+    const blockSize = 1 << (cls + emnapiBufferPool.MIN_SHIFT)
+    if (!force && emnapiBufferPool.pooledBytes + blockSize > emnapiBufferPool.MAX_POOLED_BYTES) {
+      return false
+    }
+    emnapiBufferPool.pooledBytes += blockSize
+    emnapiBufferPool.freeLists[cls].push(pointer)
+    return true
+  },
+
+  pin: function (pointer: number, size: number): void {
+    emnapiBufferPool.pinned.add(pointer)
+    emnapiBufferPool.put(pointer, size, true)
+  },
+
+  release: function (pointer: number, size: number): void {
+    if (!emnapiBufferPool.put(pointer, size, emnapiBufferPool.pinned.has(pointer))) {
+      _free($to64('pointer') as number)
+    }
+  }
+}
+
+emnapiDefineVar(
+  '$emnapiBufferPool',
+  emnapiBufferPool,
+  ['malloc', 'free', '$emnapiInit'],
+  'emnapiBufferPool.init();'
 )
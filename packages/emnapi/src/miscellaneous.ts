@@ -8,3 +8,12 @@ function __emnapi_get_filename (env: napi_env, buf: char_p, len: int): int {
 }
 
 emnapiImplementInternal('_emnapi_get_filename', 'ippi', __emnapi_get_filename, ['$emnapiString'])
+
+function __emnapi_adjust_external_memory (env: napi_env, change_in_bytes: double): void {
+  const envObject = emnapiCtx.envStore.get(env)!
+  // napi_adjust_external_memory may have grown the memory just now
+  emnapiExternalMemory.checkMemoryGrowth()
+  envObject.adjustExternalMemory(change_in_bytes)
+}
+
+emnapiImplementInternal('_emnapi_adjust_external_memory', 'vpd', __emnapi_adjust_external_memory, ['$emnapiExternalMemory'])
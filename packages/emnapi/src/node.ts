@@ -5,8 +5,8 @@ function __emnapi_node_emit_async_init (
   result: Pointer<[double, double]>
 ): void {
   if (!emnapiNodeBinding) return
-  const resource = emnapiCtx.handleStore.get(async_resource)!.value
-  const resource_name = emnapiCtx.handleStore.get(async_resource_name)!.value
+  const resource = emnapiCtx.handleStore.getValue(async_resource)
+  const resource_name = emnapiCtx.handleStore.getValue(async_resource_name)
 
   const asyncContext = emnapiNodeBinding.node.emitAsyncInit(resource, resource_name, trigger_async_id)
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
@@ -28,7 +28,7 @@ function __emnapi_node_emit_async_destroy (async_id: double, trigger_async_id: d
 
 /* function __emnapi_node_open_callback_scope (async_resource: napi_value, async_id: double, trigger_async_id: double, result: Pointer<int64_t>): void {
   if (!emnapiNodeBinding || !result) return
-  const resource = emnapiCtx.handleStore.get(async_resource)!.value
+  const resource = emnapiCtx.handleStore.getValue(async_resource)
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const nativeCallbackScopePointer = emnapiNodeBinding.node.openCallbackScope(resource, {
     asyncId: async_id,
@@ -52,15 +52,15 @@ function __emnapi_node_make_callback (env: napi_env, async_resource: napi_value,
   let v: number
 
   if (!emnapiNodeBinding) return
-  const resource = emnapiCtx.handleStore.get(async_resource)!.value
-  const callback = emnapiCtx.handleStore.get(cb)!.value
+  const resource = emnapiCtx.handleStore.getValue(async_resource)
+  const callback = emnapiCtx.handleStore.getValue(cb)
   $from64('argv')
   $from64('size')
   size = size >>> 0
   const arr = Array(size)
   for (; i < size; i++) {
     const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-    arr[i] = emnapiCtx.handleStore.get(argVal)!.value
+    arr[i] = emnapiCtx.handleStore.getValue(argVal)
   }
   const ret = emnapiNodeBinding.node.makeCallback(resource, callback, arr, {
     asyncId: async_id,
@@ -83,10 +83,10 @@ function __emnapi_async_init_js (async_resource: napi_value, async_resource_name
   let resource: object | undefined
 
   if (async_resource) {
-    resource = Object(emnapiCtx.handleStore.get(async_resource)!.value)
+    resource = Object(emnapiCtx.handleStore.getValue(async_resource))
   }
 
-  const name = emnapiCtx.handleStore.get(async_resource_name)!.value
+  const name = emnapiCtx.handleStore.getValue(async_resource_name)
   const ret = emnapiNodeBinding.napi.asyncInit(resource, name)
   if (ret.status !== 0) return ret.status
 
@@ -148,8 +148,8 @@ function napi_make_callback (env: napi_env, async_context: Pointer<int64_t>, rec
       $CHECK_ARG!(envObject, argv)
     }
 
-    const v8recv = Object(emnapiCtx.handleStore.get(recv)!.value)
-    const v8func = emnapiCtx.handleStore.get(func)!.value
+    const v8recv = Object(emnapiCtx.handleStore.getValue(recv))
+    const v8func = emnapiCtx.handleStore.getValue(func)
     if (typeof v8func !== 'function') {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
@@ -165,7 +165,7 @@ function napi_make_callback (env: napi_env, async_context: Pointer<int64_t>, rec
     const arr = Array(argc)
     for (; i < argc; i++) {
       const argVal = $makeGetValue('argv', 'i * ' + POINTER_SIZE, '*')
-      arr[i] = emnapiCtx.handleStore.get(argVal)!.value
+      arr[i] = emnapiCtx.handleStore.getValue(argVal)
     }
     const ret = emnapiNodeBinding.napi.makeCallback(ctx, v8recv, v8func, arr)
     if (ret.error) {
@@ -27,7 +27,7 @@ function napi_resolve_deferred (env: napi_env, deferred: napi_deferred, resoluti
     $CHECK_ARG!(envObject, deferred)
     $CHECK_ARG!(envObject, resolution)
     const deferredObject = emnapiCtx.deferredStore.get(deferred)!
-    deferredObject.resolve(emnapiCtx.handleStore.get(resolution)!.value)
+    deferredObject.resolve(emnapiCtx.handleStore.getValue(resolution))
     return envObject.getReturnStatus()
   })
 }
@@ -37,7 +37,7 @@ function napi_reject_deferred (env: napi_env, deferred: napi_deferred, resolutio
     $CHECK_ARG!(envObject, deferred)
     $CHECK_ARG!(envObject, resolution)
     const deferredObject = emnapiCtx.deferredStore.get(deferred)!
-    deferredObject.reject(emnapiCtx.handleStore.get(resolution)!.value)
+    deferredObject.reject(emnapiCtx.handleStore.getValue(resolution))
     return envObject.getReturnStatus()
   })
 }
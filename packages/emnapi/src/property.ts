@@ -153,7 +153,7 @@ function napi_set_property (env: napi_env, object: napi_value, key: napi_value,
     if (!(h.isObject() || h.isFunction())) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    h.value[emnapiCtx.handleStore.get(key)!.value] = emnapiCtx.handleStore.get(value)!.value
+    h.value[emnapiCtx.handleStore.getValue(key)] = emnapiCtx.handleStore.getValue(value)
     return envObject.getReturnStatus()
   })
 }
@@ -177,7 +177,7 @@ function napi_has_property (env: napi_env, object: napi_value, key: napi_value,
       return envObject.setLastError(napi_status.napi_object_expected)
     }
     $from64('result')
-    r = (emnapiCtx.handleStore.get(key)!.value in v) ? 1 : 0
+    r = (emnapiCtx.handleStore.getValue(key) in v) ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
     return envObject.getReturnStatus()
   })
@@ -203,7 +203,7 @@ function napi_get_property (env: napi_env, object: napi_value, key: napi_value,
     }
     $from64('result')
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    value = envObject.ensureHandleId(v[emnapiCtx.handleStore.get(key)!.value])
+    value = envObject.ensureHandleId(v[emnapiCtx.handleStore.getValue(key)])
     $makeSetValue('result', 0, 'value', '*')
     return envObject.getReturnStatus()
   })
@@ -220,7 +220,7 @@ function napi_delete_property (env: napi_env, object: napi_value, key: napi_valu
     if (!(h.isObject() || h.isFunction())) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    const propertyKey = emnapiCtx.handleStore.get(key)!.value
+    const propertyKey = emnapiCtx.handleStore.getValue(key)
     if (emnapiCtx.feature.supportReflect) {
       r = Reflect.deleteProperty(h.value, propertyKey)
     } else {
@@ -256,11 +256,11 @@ function napi_has_own_property (env: napi_env, object: napi_value, key: napi_val
     } catch (_) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    const prop = emnapiCtx.handleStore.get(key)!.value
+    const prop = emnapiCtx.handleStore.getValue(key)
     if (typeof prop !== 'string' && typeof prop !== 'symbol') {
       return envObject.setLastError(napi_status.napi_name_expected)
     }
-    r = Object.prototype.hasOwnProperty.call(v, emnapiCtx.handleStore.get(key)!.value)
+    r = Object.prototype.hasOwnProperty.call(v, emnapiCtx.handleStore.getValue(key))
     $from64('result')
     $makeSetValue('result', 0, 'r ? 1 : 0', 'i8')
     return envObject.getReturnStatus()
@@ -279,7 +279,7 @@ function napi_set_named_property (env: napi_env, object: napi_value, cname: cons
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
     $from64('cname')
-    emnapiCtx.handleStore.get(object)!.value[emnapiString.UTF8ToString(cname, -1)] = emnapiCtx.handleStore.get(value)!.value
+    emnapiCtx.handleStore.getValue(object)[emnapiString.UTF8ToString(cname, -1)] = emnapiCtx.handleStore.getValue(value)
     return napi_status.napi_ok
   })
 }
@@ -351,7 +351,7 @@ function napi_set_element (env: napi_env, object: napi_value, index: uint32_t, v
     if (!(h.isObject() || h.isFunction())) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
-    h.value[index >>> 0] = emnapiCtx.handleStore.get(value)!.value
+    h.value[index >>> 0] = emnapiCtx.handleStore.getValue(value)
     return envObject.getReturnStatus()
   })
 }
@@ -438,9 +438,6 @@ function napi_define_properties (
   property_count: size_t,
   properties: Const<Pointer<napi_property_descriptor>>
 ): napi_status {
-  // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  let propPtr: number, attributes: number
-
   return $PREAMBLE!(env, (envObject) => {
     $from64('properties')
     $from64('property_count')
@@ -457,34 +454,39 @@ function napi_define_properties (
       return envObject.setLastError(napi_status.napi_object_expected)
     }
 
-    let propertyName: string | symbol
+    const status = emnapiDefineProperties(envObject, maybeObject, undefined, LazyMethod.None, property_count, properties)
+    if (status !== napi_status.napi_ok) return envObject.setLastError(status)
+    return napi_status.napi_ok
+  })
+}
 
-    for (let i = 0; i < property_count; i++) {
-      // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      propPtr = properties + (i * ($POINTER_SIZE * 8))
-      const utf8Name = $makeGetValue('propPtr', 0, '*')
-      const name = $makeGetValue('propPtr', POINTER_SIZE, '*')
-      const method = $makeGetValue('propPtr', POINTER_SIZE * 2, '*')
-      const getter = $makeGetValue('propPtr', POINTER_SIZE * 3, '*')
-      const setter = $makeGetValue('propPtr', POINTER_SIZE * 4, '*')
-      const value = $makeGetValue('propPtr', POINTER_SIZE * 5, '*')
-      attributes = $makeGetValue('propPtr', POINTER_SIZE * 6, POINTER_WASM_TYPE) as number
-      $from64('attributes')
-      const data = $makeGetValue('propPtr', POINTER_SIZE * 7, '*')
+// Same as napi_define_properties, except that configurable methods are
+// created on first access. Until then such a method is an accessor on
+// `object`.
+function emnapi_define_lazy_properties (
+  env: napi_env,
+  object: napi_value,
+  property_count: size_t,
+  properties: Const<Pointer<napi_property_descriptor>>
+): napi_status {
+  return $PREAMBLE!(env, (envObject) => {
+    $from64('properties')
+    $from64('property_count')
 
-      if (utf8Name) {
-        propertyName = emnapiString.UTF8ToString(utf8Name, -1)
-      } else {
-        if (!name) {
-          return envObject.setLastError(napi_status.napi_name_expected)
-        }
-        propertyName = emnapiCtx.handleStore.get(name)!.value
-        if (typeof propertyName !== 'string' && typeof propertyName !== 'symbol') {
-          return envObject.setLastError(napi_status.napi_name_expected)
-        }
-      }
-      emnapiDefineProperty(envObject, maybeObject, propertyName, method, getter, setter, value, attributes, data)
+    property_count = property_count >>> 0
+
+    if (property_count > 0) {
+      if (!properties) return envObject.setLastError(napi_status.napi_invalid_arg)
+    }
+    if (!object) return envObject.setLastError(napi_status.napi_invalid_arg)
+    const h = emnapiCtx.handleStore.get(object)!
+    const maybeObject = h.value
+    if (!(h.isObject() || h.isFunction())) {
+      return envObject.setLastError(napi_status.napi_object_expected)
     }
+
+    const status = emnapiDefineProperties(envObject, maybeObject, undefined, LazyMethod.Configurable, property_count, properties)
+    if (status !== napi_status.napi_ok) return envObject.setLastError(status)
     return napi_status.napi_ok
   })
 }
@@ -529,6 +531,8 @@ emnapiImplement('napi_set_element', 'ippip', napi_set_element)
 emnapiImplement('napi_has_element', 'ippip', napi_has_element)
 emnapiImplement('napi_get_element', 'ippip', napi_get_element)
 emnapiImplement('napi_delete_element', 'ippip', napi_delete_element)
-emnapiImplement('napi_define_properties', 'ipppp', napi_define_properties, ['$emnapiDefineProperty', '$emnapiString'])
+emnapiImplement('napi_define_properties', 'ipppp', napi_define_properties, ['$emnapiDefineProperties'])
 emnapiImplement('napi_object_freeze', 'ipp', napi_object_freeze)
 emnapiImplement('napi_object_seal', 'ipp', napi_object_seal)
+
+emnapiImplement2('emnapi_define_lazy_properties', 'ipppp', emnapi_define_lazy_properties, ['$emnapiDefineProperties'])
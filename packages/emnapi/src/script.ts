@@ -12,7 +12,7 @@ function napi_run_script (env: napi_env, script: napi_value, result: Pointer<nap
     if (!v8Script.isString()) {
       return envObject.setLastError(napi_status.napi_string_expected)
     }
-    const g: typeof globalThis = emnapiCtx.handleStore.get(GlobalHandle.GLOBAL)!.value
+    const g: typeof globalThis = emnapiCtx.handleStore.getValue(GlobalHandle.GLOBAL)
     const ret = g.eval(v8Script.value)
     $from64('result')
 
@@ -22,9 +22,9 @@ function napi_run_script (env: napi_env, script: napi_value, result: Pointer<nap
     return envObject.getReturnStatus()
   })
 // #else
-  const status = _napi_set_last_error(env, napi_status.napi_generic_failure, 0, 0)
+  const status = emnapiCtx.envStore.get(env)!.setLastError(napi_status.napi_generic_failure, 0, 0)
 // #endif
   return status
 }
 
-emnapiImplement('napi_run_script', 'ippp', napi_run_script, ['napi_set_last_error'])
+emnapiImplement('napi_run_script', 'ippp', napi_run_script)
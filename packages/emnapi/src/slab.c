@@ -0,0 +1,174 @@
+#include "emnapi_internal.h"
+
+#if EMNAPI_HAVE_THREADS
+
+#include <pthread.h>
+#include <string.h>
+
+EXTERN_C_START
+
+// Size-classed allocator for the small objects the runtime creates
+// per call: async works, async contexts, threadsafe function queue
+// nodes and so on. Worker threads create and free these all the time,
+// and with dlmalloc-mt / emmalloc-mt every malloc and free takes the
+// allocator's global lock.
+//
+// Every thread keeps a free list per size class. Objects move between
+// threads in batches through a mutex-protected depot, so the lock is
+// taken once per SLAB_BATCH allocations instead of once per allocation.
+// A queue node malloc'd on a worker and freed on the main thread ends
+// up in the main thread's cache, which hands full batches back to the
+// depot, where the worker picks them up again.
+//
+// Memory is carved from malloc'd chunks of SLAB_BATCH objects and is
+// never given back to malloc, so the pool stays at its peak size.
+
+#define SLAB_GRANULE 16
+#define SLAB_CLASS_COUNT 16
+#define SLAB_MAX_SIZE (SLAB_GRANULE * SLAB_CLASS_COUNT)
+#define SLAB_BATCH 32
+
+// a free object, `next_batch` is only used by the first object
+// of a batch in the depot
+typedef struct slab_free_object {
+  struct slab_free_object* next;
+  struct slab_free_object* next_batch;
+} slab_free_object;
+
+typedef struct slab_depot {
+  pthread_mutex_t mutex;
+  slab_free_object* batches;
+} slab_depot;
+
+typedef struct slab_cache {
+  slab_free_object* head;
+  unsigned int count;
+} slab_cache;
+
+static slab_depot depots[SLAB_CLASS_COUNT] = {
+#define X { PTHREAD_MUTEX_INITIALIZER, NULL }
+  X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X
+#undef X
+};
+
+static _Thread_local slab_cache caches[SLAB_CLASS_COUNT];
+static _Thread_local int cache_registered = 0;
+
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t key;
+
+static inline unsigned int slab_class(size_t size) {
+  return (unsigned int) ((size + SLAB_GRANULE - 1) / SLAB_GRANULE) - 1;
+}
+
+static void slab_depot_push(unsigned int cls,
+                            slab_free_object* batch) {
+  slab_depot* depot = depots + cls;
+  pthread_mutex_lock(&depot->mutex);
+  batch->next_batch = depot->batches;
+  depot->batches = batch;
+  pthread_mutex_unlock(&depot->mutex);
+}
+
+// gives the objects of a dying thread back to the depot
+static void slab_thread_exit(void* arg) {
+  slab_cache* cache = (slab_cache*) arg;
+  for (unsigned int cls = 0; cls < SLAB_CLASS_COUNT; ++cls) {
+    if (cache[cls].head != NULL) {
+      slab_depot_push(cls, cache[cls].head);
+      cache[cls].head = NULL;
+      cache[cls].count = 0;
+    }
+  }
+}
+
+static void slab_make_key(void) {
+  pthread_key_create(&key, slab_thread_exit);
+}
+
+static void slab_register_thread(void) {
+  pthread_once(&key_once, slab_make_key);
+  pthread_setspecific(key, caches);
+  cache_registered = 1;
+}
+
+// refills an empty cache from the depot or from a new chunk
+static int slab_refill(slab_cache* cache, unsigned int cls) {
+  slab_depot* depot = depots + cls;
+  slab_free_object* batch;
+  pthread_mutex_lock(&depot->mutex);
+  batch = depot->batches;
+  if (batch != NULL) {
+    depot->batches = batch->next_batch;
+  }
+  pthread_mutex_unlock(&depot->mutex);
+
+  if (batch != NULL) {
+    // the cache of a dying thread is pushed as a single batch
+    // of any length, so count it
+    unsigned int count = 0;
+    for (slab_free_object* obj = batch; obj != NULL; obj = obj->next) count++;
+    cache->head = batch;
+    cache->count = count;
+    return 1;
+  }
+
+  size_t size = (cls + 1) * SLAB_GRANULE;
+  char* chunk = (char*) malloc(size * SLAB_BATCH);
+  if (chunk == NULL) return 0;
+  for (unsigned int i = 0; i < SLAB_BATCH - 1; ++i) {
+    ((slab_free_object*) (chunk + i * size))->next =
+      (slab_free_object*) (chunk + (i + 1) * size);
+  }
+  ((slab_free_object*) (chunk + (SLAB_BATCH - 1) * size))->next = NULL;
+  cache->head = (slab_free_object*) chunk;
+  cache->count = SLAB_BATCH;
+  return 1;
+}
+
+void* _emnapi_slab_alloc(size_t size) {
+  if (size == 0 || size > SLAB_MAX_SIZE) return malloc(size);
+  if (!cache_registered) slab_register_thread();
+  unsigned int cls = slab_class(size);
+  slab_cache* cache = caches + cls;
+  if (cache->head == NULL && !slab_refill(cache, cls)) return NULL;
+  slab_free_object* obj = cache->head;
+  cache->head = obj->next;
+  cache->count--;
+  return obj;
+}
+
+void* _emnapi_slab_calloc(size_t size) {
+  void* p = _emnapi_slab_alloc(size);
+  if (p != NULL) memset(p, 0, size);
+  return p;
+}
+
+void _emnapi_slab_free(void* p, size_t size) {
+  if (p == NULL) return;
+  if (size == 0 || size > SLAB_MAX_SIZE) {
+    free(p);
+    return;
+  }
+  if (!cache_registered) slab_register_thread();
+  unsigned int cls = slab_class(size);
+  slab_cache* cache = caches + cls;
+  slab_free_object* obj = (slab_free_object*) p;
+  obj->next = cache->head;
+  cache->head = obj;
+  // keep at most two batches, so that a thread which only frees
+  // does not hoard what a thread which only allocates needs
+  if (++cache->count >= 2 * SLAB_BATCH) {
+    slab_free_object* batch = cache->head;
+    slab_free_object* last = batch;
+    for (unsigned int i = 1; i < SLAB_BATCH; ++i) last = last->next;
+    cache->head = last->next;
+    cache->count -= SLAB_BATCH;
+    last->next = NULL;
+    slab_depot_push(cls, batch);
+  }
+}
+
+EXTERN_C_END
+
+#endif
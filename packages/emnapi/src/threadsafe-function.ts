@@ -65,52 +65,72 @@ const emnapiTSFN = {
     }
     return true
   },
+  // The queue is a ring of data pointers in wasm memory, a header of
+  // u32 capacity, u32 head and u32 tail followed by `capacity` slots.
+  // head and tail only grow and wrap around, the capacity is a power of
+  // two. Items are pushed and shifted with the mutex held, the ring is
+  // reallocated with twice the capacity when it is full.
+  queueHeaderSize: 16,
   initQueue (func: number): boolean {
-    const size = 2 * $POINTER_SIZE
-    const queue = _malloc($to64('size'))
+    const queue = emnapiTSFN.allocQueue(16)
     if (!queue) return false
-    new Uint8Array(wasmMemory.buffer, queue, size).fill(0)
     emnapiTSFN.storeSizeTypeValue(func + emnapiTSFN.offset.queue, queue, false)
     return true
   },
+  allocQueue (capacity: number): number {
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const size = emnapiTSFN.queueHeaderSize + capacity * $POINTER_SIZE
+    const queue = _malloc($to64('size'))
+    if (!queue) return 0
+    const u32 = new Uint32Array(wasmMemory.buffer, queue, 3)
+    Atomics.store(u32, 0, capacity)
+    Atomics.store(u32, 1, 0)
+    Atomics.store(u32, 2, 0)
+    return queue
+  },
   destroyQueue (func: number) {
     const queue = emnapiTSFN.loadSizeTypeValue(func + emnapiTSFN.offset.queue, false)
     if (queue) {
       _free($to64('queue') as number)
     }
   },
+  growQueue (func: number, queue: number): number {
+    const u32 = new Uint32Array(wasmMemory.buffer, queue, 3)
+    const capacity = u32[0]
+    const head = Atomics.load(u32, 1)
+    const newQueue = emnapiTSFN.allocQueue(capacity * 2)
+    if (!newQueue) throw new Error('OOM')
+    const slots = queue + emnapiTSFN.queueHeaderSize
+    const newSlots = newQueue + emnapiTSFN.queueHeaderSize
+    for (let i = 0; i < capacity; ++i) {
+      const value = emnapiTSFN.loadSizeTypeValue(slots + ((head + i) & (capacity - 1)) * $POINTER_SIZE, false)
+      emnapiTSFN.storeSizeTypeValue(newSlots + i * $POINTER_SIZE, value, false)
+    }
+    Atomics.store(new Uint32Array(wasmMemory.buffer, newQueue, 3), 2, capacity)
+    emnapiTSFN.storeSizeTypeValue(func + emnapiTSFN.offset.queue, newQueue, false)
+    _free($to64('queue') as number)
+    return newQueue
+  },
   pushQueue (func: number, data: number): void {
-    const queue = emnapiTSFN.loadSizeTypeValue(func + emnapiTSFN.offset.queue, false)
-    const head = emnapiTSFN.loadSizeTypeValue(queue, false)
-    const tail = emnapiTSFN.loadSizeTypeValue(queue + $POINTER_SIZE, false)
-    // eslint-disable-next-line @typescript-eslint/no-unused-vars
-    const size = 2 * $POINTER_SIZE
-    const node = _malloc($to64('size'))
-    if (!node) throw new Error('OOM')
-    emnapiTSFN.storeSizeTypeValue(node, data, false)
-    emnapiTSFN.storeSizeTypeValue(node + $POINTER_SIZE, 0, false)
-    if (head === 0 && tail === 0) {
-      emnapiTSFN.storeSizeTypeValue(queue, node, false)
-      emnapiTSFN.storeSizeTypeValue(queue + $POINTER_SIZE, node, false)
-    } else {
-      emnapiTSFN.storeSizeTypeValue(tail + $POINTER_SIZE, node, false)
-      emnapiTSFN.storeSizeTypeValue(queue + $POINTER_SIZE, node, false)
+    let queue = emnapiTSFN.loadSizeTypeValue(func + emnapiTSFN.offset.queue, false)
+    let u32 = new Uint32Array(wasmMemory.buffer, queue, 3)
+    if (((Atomics.load(u32, 2) - Atomics.load(u32, 1)) >>> 0) === u32[0]) {
+      queue = emnapiTSFN.growQueue(func, queue)
+      u32 = new Uint32Array(wasmMemory.buffer, queue, 3)
     }
+    const capacity = u32[0]
+    const tail = Atomics.load(u32, 2)
+    emnapiTSFN.storeSizeTypeValue(queue + emnapiTSFN.queueHeaderSize + (tail & (capacity - 1)) * $POINTER_SIZE, data, false)
+    Atomics.store(u32, 2, (tail + 1) >>> 0)
     emnapiTSFN.addQueueSize(func)
   },
   shiftQueue (func: number): number {
     const queue = emnapiTSFN.loadSizeTypeValue(func + emnapiTSFN.offset.queue, false)
-    const head = emnapiTSFN.loadSizeTypeValue(queue, false)
-    if (head === 0) return 0
-    const node = head
-    const next = emnapiTSFN.loadSizeTypeValue(head + $POINTER_SIZE, false)
-    emnapiTSFN.storeSizeTypeValue(queue, next, false)
-    if (next === 0) {
-      emnapiTSFN.storeSizeTypeValue(queue + $POINTER_SIZE, 0, false)
-    }
-    emnapiTSFN.storeSizeTypeValue(node + $POINTER_SIZE, 0, false)
-    const value = emnapiTSFN.loadSizeTypeValue(node, false)
-    _free($to64('node') as number)
+    const u32 = new Uint32Array(wasmMemory.buffer, queue, 3)
+    const head = Atomics.load(u32, 1)
+    if (head === Atomics.load(u32, 2)) return 0
+    const value = emnapiTSFN.loadSizeTypeValue(queue + emnapiTSFN.queueHeaderSize + (head & (u32[0] - 1)) * $POINTER_SIZE, false)
+    Atomics.store(u32, 1, (head + 1) >>> 0)
     emnapiTSFN.subQueueSize(func)
     return value
   },
@@ -463,7 +483,7 @@ const emnapiTSFN = {
         if (emnapiNodeBinding) {
           const resource = emnapiTSFN.getResource(func)
           const resource_value = emnapiCtx.refStore.get(resource)!.get()
-          const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+          const resourceObject = emnapiCtx.handleStore.getValue(resource_value)
           const view = new DataView(wasmMemory.buffer)
           const asyncId = view.getFloat64(func + emnapiTSFN.offset.async_id, true)
           const triggerAsyncId = view.getFloat64(func + emnapiTSFN.offset.trigger_async_id, true)
@@ -558,7 +578,7 @@ const emnapiTSFN = {
             const context = emnapiTSFN.getContext(func)
             $makeDynCall('vpppp', 'callJsCb')($to64('env'), $to64('js_callback'), $to64('context'), $to64('data'))
           } else {
-            const jsCallback = js_callback ? emnapiCtx.handleStore.get(js_callback)!.value : null
+            const jsCallback = js_callback ? emnapiCtx.handleStore.getValue(js_callback) : null
             if (typeof jsCallback === 'function') {
               jsCallback()
             }
@@ -570,7 +590,7 @@ const emnapiTSFN = {
         if (emnapiNodeBinding) {
           const resource = emnapiTSFN.getResource(func)
           const resource_value = emnapiCtx.refStore.get(resource)!.get()
-          const resourceObject = emnapiCtx.handleStore.get(resource_value)!.value
+          const resourceObject = emnapiCtx.handleStore.getValue(resource_value)
           const view = new DataView(wasmMemory.buffer)
           emnapiNodeBinding.node.makeCallback(resourceObject, f, [], {
             asyncId: view.getFloat64(func + emnapiTSFN.offset.async_id, true),
@@ -607,7 +627,9 @@ const emnapiTSFN = {
   },
   send (func: number): void {
     const current_state = Atomics.or(new Uint32Array(wasmMemory.buffer), (func + emnapiTSFN.offset.dispatch_state) >> 2, 1 << 1)
-    if ((current_state & 1) === 1) {
+    // a running dispatch picks the new item up, and a pending one means
+    // a wakeup is already on its way, so there is one message per cycle
+    if (current_state !== 0) {
       return
     }
     if (ENVIRONMENT_IS_PTHREAD) {
@@ -662,7 +684,7 @@ function _napi_create_threadsafe_function (
   if (!func) {
     $CHECK_ARG!(envObject, call_js_cb)
   } else {
-    const funcValue = emnapiCtx.handleStore.get(func)!.value
+    const funcValue = emnapiCtx.handleStore.getValue(func)
     if (typeof funcValue !== 'function') {
       return envObject.setLastError(napi_status.napi_invalid_arg)
     }
@@ -672,7 +694,7 @@ function _napi_create_threadsafe_function (
 
   let asyncResourceObject: any
   if (async_resource) {
-    asyncResourceObject = emnapiCtx.handleStore.get(async_resource)!.value
+    asyncResourceObject = emnapiCtx.handleStore.getValue(async_resource)
     if (asyncResourceObject == null) {
       return envObject.setLastError(napi_status.napi_object_expected)
     }
@@ -682,7 +704,7 @@ function _napi_create_threadsafe_function (
   }
   const resource = envObject.ensureHandleId(asyncResourceObject)
 
-  let asyncResourceName = emnapiCtx.handleStore.get(async_resource_name)!.value
+  let asyncResourceName = emnapiCtx.handleStore.getValue(async_resource_name)
   if (typeof asyncResourceName === 'symbol') {
     return envObject.setLastError(napi_status.napi_string_expected)
   }
@@ -127,11 +127,12 @@ static void _emnapi_tsfn_destroy(napi_threadsafe_function func) {
 
   QUEUE* tmp;
   struct data_queue_node* node;
-  QUEUE_FOREACH(tmp, &func->queue) {
+  while (!QUEUE_EMPTY(&func->queue)) {
+    tmp = QUEUE_HEAD(&func->queue);
+    QUEUE_REMOVE(tmp);
     node = QUEUE_DATA(tmp, struct data_queue_node, q);
-    free(node);
+    EMNAPI_SLAB_FREE(node, sizeof(struct data_queue_node));
   }
-  QUEUE_INIT(&func->queue);
 
   if (func->ref != NULL) {
     EMNAPI_ASSERT_CALL(napi_delete_reference(func->env, func->ref));
@@ -196,7 +197,7 @@ static void _emnapi_tsfn_empty_queue_and_delete(napi_threadsafe_function func) {
     QUEUE_REMOVE(q);
     QUEUE_INIT(q);
     func->queue_size--;
-    free(node);
+    EMNAPI_SLAB_FREE(node, sizeof(struct data_queue_node));
   }
   _emnapi_tsfn_destroy(func);
 }
@@ -301,7 +302,7 @@ static bool _emnapi_tsfn_dispatch_one(napi_threadsafe_function func) {
         QUEUE_INIT(q);
         func->queue_size--;
         data = node->data;
-        free(node);
+        EMNAPI_SLAB_FREE(node, sizeof(struct data_queue_node));
         popped_value = true;
         if (size == func->max_queue_size && func->max_queue_size > 0) {
           pthread_cond_signal(func->cond);
@@ -513,7 +514,7 @@ napi_call_threadsafe_function(napi_threadsafe_function func,
       return napi_closing;
     }
   } else {
-    struct data_queue_node* queue_node = (struct data_queue_node*) malloc(sizeof(struct data_queue_node));
+    struct data_queue_node* queue_node = (struct data_queue_node*) EMNAPI_SLAB_ALLOC(sizeof(struct data_queue_node));
     if (queue_node == NULL) {
       pthread_mutex_unlock(&func->mutex);
       return napi_generic_failure;
@@ -2,3 +2,10 @@ declare const enum UnwrapAction {
   KeepWrap,
   RemoveWrap
 }
+
+declare const enum LazyMethod {
+  // create every method up front
+  None,
+  // defer the methods that are configurable
+  Configurable
+}
@@ -1,15 +1,5 @@
 /* eslint-disable @typescript-eslint/indent */
 
-function _napi_set_last_error (env: napi_env, error_code: napi_status, engine_error_code: uint32_t, engine_reserved: void_p): napi_status {
-  const envObject = emnapiCtx.envStore.get(env)!
-  return envObject.setLastError(error_code, engine_error_code, engine_reserved)
-}
-
-function _napi_clear_last_error (env: napi_env): napi_status {
-  const envObject = emnapiCtx.envStore.get(env)!
-  return envObject.clearLastError()
-}
-
 declare const process: any
 function __emnapi_get_node_version (major: number, minor: number, patch: number): void {
   $from64('major')
@@ -31,8 +21,6 @@ function __emnapi_get_node_version (major: number, minor: number, patch: number)
   $makeSetValue('patch', 0, 'versions[2]', 'u32')
 }
 
-emnapiImplementInternal('napi_set_last_error', 'ipiip', _napi_set_last_error)
-emnapiImplementInternal('napi_clear_last_error', 'ip', _napi_clear_last_error)
 emnapiImplementInternal('_emnapi_get_node_version', 'vp', __emnapi_get_node_version)
 
 function __emnapi_runtime_keepalive_push (): void {
@@ -46,17 +34,108 @@ function __emnapi_runtime_keepalive_pop (): void {
 emnapiImplementInternal('_emnapi_runtime_keepalive_push', 'v', __emnapi_runtime_keepalive_push, ['$runtimeKeepalivePush'])
 emnapiImplementInternal('_emnapi_runtime_keepalive_pop', 'v', __emnapi_runtime_keepalive_pop, ['$runtimeKeepalivePop'])
 
+declare interface DispatchQueue {
+  callbacks: Float64Array
+  data: Float64Array
+  head: number
+  size: number
+  scheduled: boolean
+  schedule: (flush: () => void) => void
+  flush: () => void
+}
+
+// (callback, data) pairs queued by _emnapi_set_immediate and
+// _emnapi_next_tick. A burst of calls is flushed in FIFO order
+// by a single setImmediate / microtask instead of one per call.
+const emnapiDispatchQueue = {
+  immediate: undefined as unknown as DispatchQueue,
+  tick: undefined as unknown as DispatchQueue,
+
+  init: function (): void {
+    emnapiDispatchQueue.immediate = emnapiDispatchQueue.create(function (flush) {
+      emnapiCtx.feature.setImmediate(flush)
+    })
+    emnapiDispatchQueue.tick = emnapiDispatchQueue.create(function (flush) {
+      // eslint-disable-next-line @typescript-eslint/no-floating-promises
+      Promise.resolve().then(flush)
+    })
+  },
+
+  create: function (schedule: (flush: () => void) => void): DispatchQueue {
+    const queue: DispatchQueue = {
+      // capacity is always a power of two
+      callbacks: new Float64Array(16),
+      data: new Float64Array(16),
+      head: 0,
+      size: 0,
+      scheduled: false,
+      schedule,
+      flush: function () { emnapiDispatchQueue.flush(queue) }
+    }
+    return queue
+  },
+
+  push: function (queue: DispatchQueue, callback: number, data: number): void {
+    let capacity = queue.callbacks.length
+    if (queue.size === capacity) {
+      const callbacks = new Float64Array(capacity << 1)
+      const values = new Float64Array(capacity << 1)
+      for (let i = 0; i < capacity; ++i) {
+        const index = (queue.head + i) & (capacity - 1)
+        callbacks[i] = queue.callbacks[index]
+        values[i] = queue.data[index]
+      }
+      queue.callbacks = callbacks
+      queue.data = values
+      queue.head = 0
+      capacity <<= 1
+    }
+    const tail = (queue.head + queue.size) & (capacity - 1)
+    queue.callbacks[tail] = callback
+    queue.data[tail] = data
+    queue.size++
+    if (!queue.scheduled) {
+      queue.scheduled = true
+      queue.schedule(queue.flush)
+    }
+  },
+
+  flush: function (queue: DispatchQueue): void {
+    queue.scheduled = false
+    // entries queued by the callbacks run in the next flush
+    let count = queue.size
+    try {
+      while (count-- > 0) {
+        const head = queue.head
+        const callback = queue.callbacks[head]
+        // eslint-disable-next-line @typescript-eslint/no-unused-vars
+        const data = queue.data[head]
+        queue.head = (head + 1) & (queue.callbacks.length - 1)
+        queue.size--
+        $makeDynCall('vp', 'callback')($to64('data'))
+      }
+    } finally {
+      // a callback threw, keep the rest for another flush
+      if (queue.size > 0 && !queue.scheduled) {
+        queue.scheduled = true
+        queue.schedule(queue.flush)
+      }
+    }
+  }
+}
+
+emnapiDefineVar('$emnapiDispatchQueue', emnapiDispatchQueue, [], 'emnapiDispatchQueue.init();')
+
 function __emnapi_set_immediate (callback: number, data: number): void {
-  emnapiCtx.feature.setImmediate(() => {
-    $makeDynCall('vp', 'callback')(data)
-  })
+  $from64('callback')
+  $from64('data')
+  emnapiDispatchQueue.push(emnapiDispatchQueue.immediate, callback, data)
 }
 
 function __emnapi_next_tick (callback: number, data: number): void {
-  // eslint-disable-next-line @typescript-eslint/no-floating-promises
-  Promise.resolve().then(() => {
-    $makeDynCall('vp', 'callback')(data)
-  })
+  $from64('callback')
+  $from64('data')
+  emnapiDispatchQueue.push(emnapiDispatchQueue.tick, callback, data)
 }
 
 function __emnapi_callback_into_module (forceUncaught: int, env: napi_env, callback: number, data: number, close_scope_if_throw: int): void {
@@ -90,8 +169,8 @@ function __emnapi_ctx_decrease_waiting_request_counter (): void {
   emnapiCtx.decreaseWaitingRequestCounter()
 }
 
-emnapiImplementInternal('_emnapi_set_immediate', 'vpp', __emnapi_set_immediate)
-emnapiImplementInternal('_emnapi_next_tick', 'vpp', __emnapi_next_tick)
+emnapiImplementInternal('_emnapi_set_immediate', 'vpp', __emnapi_set_immediate, ['$emnapiDispatchQueue'])
+emnapiImplementInternal('_emnapi_next_tick', 'vpp', __emnapi_next_tick, ['$emnapiDispatchQueue'])
 emnapiImplementInternal('_emnapi_callback_into_module', 'vipppi', __emnapi_callback_into_module)
 emnapiImplementInternal('_emnapi_call_finalizer', 'vipppp', __emnapi_call_finalizer)
 emnapiImplementInternal('_emnapi_ctx_increase_waiting_request_counter', 'v', __emnapi_ctx_increase_waiting_request_counter)
@@ -58,6 +58,16 @@ static void uv__cancelled(struct uv__work* w) {
 
 EMNAPI_INTERNAL_EXTERN void _emnapi_worker_unref(uv_thread_t pid);
 
+#ifndef EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+#define EMNAPI_ASYNC_WORK_BATCH_COMPLETE 0
+#endif
+
+#if EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+/* Defined in async_work.c, delivers the napi_async_work completions
+ * collected by the `done` callbacks of one uv__work_done call. */
+void _emnapi_async_work_flush_completions(void);
+#endif
+
 #ifdef __EMNAPI_WASI_THREADS__
 EMNAPI_INTERNAL_EXTERN
 void _emnapi_after_uvthreadpool_ready(void (*callback)(QUEUE* w, enum uv__work_kind kind),
@@ -367,6 +377,10 @@ void uv__work_done(uv_async_t* handle) {
     err = (w->work == uv__cancelled) ? ECANCELED : 0;
     w->done(w, err);
   }
+
+#if EMNAPI_ASYNC_WORK_BATCH_COMPLETE
+  _emnapi_async_work_flush_completions();
+#endif
 }
 
 
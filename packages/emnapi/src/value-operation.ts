@@ -1,4 +1,4 @@
-function napi_typeof (env: napi_env, value: napi_value, result: Pointer<napi_valuetype>): napi_status {
+function __emnapi_typeof (env: napi_env, value: napi_value, result: Pointer<napi_valuetype>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
@@ -131,7 +131,7 @@ function napi_instanceof (env: napi_env, object: napi_value, constructor: napi_v
     if (!ctor.isFunction()) {
       return envObject.setLastError(napi_status.napi_function_expected)
     }
-    const val = emnapiCtx.handleStore.get(object)!.value
+    const val = emnapiCtx.handleStore.getValue(object)
     const ret = val instanceof ctor.value
     r = ret ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
@@ -183,7 +183,7 @@ function napi_is_error (env: napi_env, value: napi_value, result: Pointer<bool>)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
   $CHECK_ARG!(envObject, result)
-  const val = emnapiCtx.handleStore.get(value)!.value
+  const val = emnapiCtx.handleStore.getValue(value)
   $from64('result')
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   const r = (val instanceof Error) ? 1 : 0
@@ -238,8 +238,8 @@ function napi_strict_equals (env: napi_env, lhs: napi_value, rhs: napi_value, re
     $CHECK_ARG!(envObject, lhs)
     $CHECK_ARG!(envObject, rhs)
     $CHECK_ARG!(envObject, result)
-    const lv = emnapiCtx.handleStore.get(lhs)!.value
-    const rv = emnapiCtx.handleStore.get(rhs)!.value
+    const lv = emnapiCtx.handleStore.getValue(lhs)
+    const rv = emnapiCtx.handleStore.getValue(rhs)
     $from64('result')
     r = (lv === rv) ? 1 : 0
     $makeSetValue('result', 0, 'r', 'i8')
@@ -251,7 +251,7 @@ function napi_detach_arraybuffer (env: napi_env, arraybuffer: napi_value): napi_
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, arraybuffer)
-  const value = emnapiCtx.handleStore.get(arraybuffer)!.value
+  const value = emnapiCtx.handleStore.getValue(arraybuffer)
   if (!(value instanceof ArrayBuffer)) {
     if (typeof SharedArrayBuffer === 'function' && (value instanceof SharedArrayBuffer)) {
       return envObject.setLastError(napi_status.napi_detachable_arraybuffer_expected)
@@ -290,7 +290,7 @@ function napi_is_detached_arraybuffer (env: napi_env, arraybuffer: napi_value, r
   })
 }
 
-emnapiImplement('napi_typeof', 'ippp', napi_typeof)
+emnapiImplementInternal('_emnapi_typeof', 'ippp', __emnapi_typeof)
 emnapiImplement('napi_coerce_to_bool', 'ippp', napi_coerce_to_bool)
 emnapiImplement('napi_coerce_to_number', 'ippp', napi_coerce_to_number)
 emnapiImplement('napi_coerce_to_object', 'ippp', napi_coerce_to_object)
@@ -304,5 +304,5 @@ emnapiImplement('napi_is_typedarray', 'ippp', napi_is_typedarray)
 emnapiImplement('napi_is_buffer', 'ippp', napi_is_buffer)
 emnapiImplement('napi_is_dataview', 'ippp', napi_is_dataview)
 emnapiImplement('napi_strict_equals', 'ipppp', napi_strict_equals)
-emnapiImplement('napi_detach_arraybuffer', 'ipp', napi_detach_arraybuffer, ['napi_set_last_error'])
-emnapiImplement('napi_is_detached_arraybuffer', 'ippp', napi_is_detached_arraybuffer, ['napi_set_last_error'])
+emnapiImplement('napi_detach_arraybuffer', 'ipp', napi_detach_arraybuffer)
+emnapiImplement('napi_is_detached_arraybuffer', 'ippp', napi_is_detached_arraybuffer)
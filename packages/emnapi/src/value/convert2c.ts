@@ -79,31 +79,9 @@ function _napi_get_typedarray_info (
   const v: ArrayBufferView = handle.value
   if (type) {
     $from64('type')
-    let t: napi_typedarray_type
-    if (v instanceof Int8Array) {
-      t = napi_typedarray_type.napi_int8_array
-    } else if (v instanceof Uint8Array) {
-      t = napi_typedarray_type.napi_uint8_array
-    } else if (v instanceof Uint8ClampedArray) {
-      t = napi_typedarray_type.napi_uint8_clamped_array
-    } else if (v instanceof Int16Array) {
-      t = napi_typedarray_type.napi_int16_array
-    } else if (v instanceof Uint16Array) {
-      t = napi_typedarray_type.napi_uint16_array
-    } else if (v instanceof Int32Array) {
-      t = napi_typedarray_type.napi_int32_array
-    } else if (v instanceof Uint32Array) {
-      t = napi_typedarray_type.napi_uint32_array
-    } else if (v instanceof Float32Array) {
-      t = napi_typedarray_type.napi_float32_array
-    } else if (v instanceof Float64Array) {
-      t = napi_typedarray_type.napi_float64_array
-    } else if (v instanceof BigInt64Array) {
-      t = napi_typedarray_type.napi_bigint64_array
-    } else if (v instanceof BigUint64Array) {
-      // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      t = napi_typedarray_type.napi_biguint64_array
-    } else {
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    const t = emnapiCtx.feature.getTypedArrayType(v)
+    if (t === -1) {
       return envObject.setLastError(napi_status.napi_generic_failure)
     }
     $makeSetValue('type', 0, 't', 'i32')
@@ -232,7 +210,7 @@ function napi_get_value_bool (env: napi_env, value: napi_value, result: Pointer<
   return envObject.clearLastError()
 }
 
-function napi_get_value_double (env: napi_env, value: napi_value, result: Pointer<double>): napi_status {
+function __emnapi_get_value_double (env: napi_env, value: napi_value, result: Pointer<double>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
@@ -394,7 +372,7 @@ function napi_get_value_external (env: napi_env, value: napi_value, result: void
   return envObject.clearLastError()
 }
 
-function napi_get_value_int32 (env: napi_env, value: napi_value, result: Pointer<int32_t>): napi_status {
+function __emnapi_get_value_int32 (env: napi_env, value: napi_value, result: Pointer<int32_t>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
@@ -408,7 +386,7 @@ function napi_get_value_int32 (env: napi_env, value: napi_value, result: Pointer
   return envObject.clearLastError()
 }
 
-function napi_get_value_int64 (env: napi_env, value: napi_value, result: Pointer<int64_t>): napi_status {
+function __emnapi_get_value_int64 (env: napi_env, value: napi_value, result: Pointer<int64_t>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
@@ -533,7 +511,7 @@ function napi_get_value_string_utf16 (env: napi_env, value: napi_value, buf: cha
   return envObject.clearLastError()
 }
 
-function napi_get_value_uint32 (env: napi_env, value: napi_value, result: Pointer<uint32_t>): napi_status {
+function __emnapi_get_value_uint32 (env: napi_env, value: napi_value, result: Pointer<uint32_t>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, value)
@@ -555,16 +533,16 @@ emnapiImplement('napi_get_buffer_info', 'ipppp', napi_get_buffer_info, ['napi_ge
 emnapiImplement('napi_get_dataview_info', 'ipppppp', napi_get_dataview_info, ['$emnapiExternalMemory'])
 emnapiImplement('napi_get_date_value', 'ippp', napi_get_date_value)
 emnapiImplement('napi_get_value_bool', 'ippp', napi_get_value_bool)
-emnapiImplement('napi_get_value_double', 'ippp', napi_get_value_double)
+emnapiImplementInternal('_emnapi_get_value_double', 'ippp', __emnapi_get_value_double)
 emnapiImplement('napi_get_value_bigint_int64', 'ipppp', napi_get_value_bigint_int64)
 emnapiImplement('napi_get_value_bigint_uint64', 'ipppp', napi_get_value_bigint_uint64)
 emnapiImplement('napi_get_value_bigint_words', 'ippppp', napi_get_value_bigint_words)
 emnapiImplement('napi_get_value_external', 'ippp', napi_get_value_external)
-emnapiImplement('napi_get_value_int32', 'ippp', napi_get_value_int32)
-emnapiImplement('napi_get_value_int64', 'ippp', napi_get_value_int64)
+emnapiImplementInternal('_emnapi_get_value_int32', 'ippp', __emnapi_get_value_int32)
+emnapiImplementInternal('_emnapi_get_value_int64', 'ippp', __emnapi_get_value_int64)
 emnapiImplement('napi_get_value_string_latin1', 'ippppp', napi_get_value_string_latin1)
 emnapiImplement('napi_get_value_string_utf8', 'ippppp', napi_get_value_string_utf8, ['$emnapiString'])
 
 emnapiImplement('napi_get_value_string_utf16', 'ippppp', napi_get_value_string_utf16, ['$emnapiString'])
 
-emnapiImplement('napi_get_value_uint32', 'ippp', napi_get_value_uint32)
+emnapiImplementInternal('_emnapi_get_value_uint32', 'ippp', __emnapi_get_value_uint32)
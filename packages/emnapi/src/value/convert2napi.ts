@@ -1,6 +1,6 @@
 /* eslint-disable @typescript-eslint/indent */
 
-function napi_create_int32 (env: napi_env, value: int32_t, result: Pointer<napi_value>): napi_status {
+function __emnapi_create_int32 (env: napi_env, value: int32_t, result: Pointer<napi_value>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, result)
@@ -11,7 +11,7 @@ function napi_create_int32 (env: napi_env, value: int32_t, result: Pointer<napi_
   return envObject.clearLastError()
 }
 
-function napi_create_uint32 (env: napi_env, value: uint32_t, result: Pointer<napi_value>): napi_status {
+function __emnapi_create_uint32 (env: napi_env, value: uint32_t, result: Pointer<napi_value>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, result)
@@ -46,7 +46,7 @@ function napi_create_int64 (env: napi_env, low: int32_t, high: int32_t, result:
   return envObject.clearLastError()
 }
 
-function napi_create_double (env: napi_env, value: double, result: Pointer<napi_value>): napi_status {
+function __emnapi_create_double (env: napi_env, value: double, result: Pointer<napi_value>): napi_status {
   $CHECK_ENV!(env)
   const envObject = emnapiCtx.envStore.get(env)!
   $CHECK_ARG!(envObject, result)
@@ -226,10 +226,10 @@ function napi_create_bigint_words (env: napi_env, sign_bit: int, word_count: siz
   })
 }
 
-emnapiImplement('napi_create_int32', 'ipip', napi_create_int32)
-emnapiImplement('napi_create_uint32', 'ipip', napi_create_uint32)
+emnapiImplementInternal('_emnapi_create_int32', 'ipip', __emnapi_create_int32)
+emnapiImplementInternal('_emnapi_create_uint32', 'ipip', __emnapi_create_uint32)
 emnapiImplement('napi_create_int64', 'ipjp', napi_create_int64)
-emnapiImplement('napi_create_double', 'ipdp', napi_create_double)
+emnapiImplementInternal('_emnapi_create_double', 'ipdp', __emnapi_create_double)
 emnapiImplement('napi_create_bigint_int64', 'ipjp', napi_create_bigint_int64)
 emnapiImplement('napi_create_bigint_uint64', 'ipjp', napi_create_bigint_uint64)
 emnapiImplement('napi_create_bigint_words', 'ipippp', napi_create_bigint_words)
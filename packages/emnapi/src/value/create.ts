@@ -244,40 +244,24 @@ function napi_create_typedarray (
       return envObject.getReturnStatus()
     }
 
-    switch (type) {
-      case napi_typedarray_type.napi_int8_array:
-        return createTypedArray(envObject, Int8Array, 1, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_uint8_array:
-        return createTypedArray(envObject, Uint8Array, 1, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_uint8_clamped_array:
-        return createTypedArray(envObject, Uint8ClampedArray, 1, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_int16_array:
-        return createTypedArray(envObject, Int16Array, 2, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_uint16_array:
-        return createTypedArray(envObject, Uint16Array, 2, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_int32_array:
-        return createTypedArray(envObject, Int32Array, 4, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_uint32_array:
-        return createTypedArray(envObject, Uint32Array, 4, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_float32_array:
-        return createTypedArray(envObject, Float32Array, 4, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_float64_array:
-        return createTypedArray(envObject, Float64Array, 8, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_bigint64_array:
-        return createTypedArray(envObject, BigInt64Array, 8, buffer, byte_offset, length)
-      case napi_typedarray_type.napi_biguint64_array:
-        return createTypedArray(envObject, BigUint64Array, 8, buffer, byte_offset, length)
-      default:
-        return envObject.setLastError(napi_status.napi_invalid_arg)
+    if (type < napi_typedarray_type.napi_int8_array || type > napi_typedarray_type.napi_biguint64_array) {
+      return envObject.setLastError(napi_status.napi_invalid_arg)
+    }
+    const Type = emnapiCtx.feature.typedArrayConstructors[type]
+    if (Type === undefined) {
+      throw emnapiCtx.createNotSupportBigIntError('napi_create_typedarray', 'BigInt typed arrays are not supported')
     }
+    return createTypedArray(envObject, Type, Type.BYTES_PER_ELEMENT, buffer, byte_offset, length)
   })
 }
 
-function napi_create_buffer (
+function emnapiCreateBuffer (
   env: napi_env,
   size: size_t,
   data: Pointer<Pointer<void>>,
-  result: Pointer<napi_value>
+  result: Pointer<napi_value>,
+  zeroFill: boolean,
+  api: string
 ): napi_status {
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   let value: number, pointer: number
@@ -287,7 +271,7 @@ function napi_create_buffer (
 
     const Buffer = emnapiCtx.feature.Buffer
     if (!Buffer) {
-      throw emnapiCtx.createNotSupportBufferError('napi_create_buffer', '')
+      throw emnapiCtx.createNotSupportBufferError(api, '')
     }
     $from64('result')
 
@@ -299,9 +283,12 @@ function napi_create_buffer (
       value = emnapiCtx.addToCurrentScope(buffer).id
       $makeSetValue('result', 0, 'value', '*')
     } else {
-      pointer = _malloc($to64('size'))
+      const pooled = emnapiBufferPool.registry !== undefined && emnapiBufferPool.sizeClass(size) !== -1
+      pointer = pooled ? emnapiBufferPool.acquire(size) : _malloc($to64('size'))
       if (!pointer) throw new Error('Out of memory')
-      new Uint8Array(wasmMemory.buffer).subarray(pointer, pointer + size).fill(0)
+      if (zeroFill) {
+        new Uint8Array(wasmMemory.buffer).subarray(pointer, pointer + size).fill(0)
+      }
       const buffer = Buffer.from(wasmMemory.buffer, pointer, size)
       const viewDescriptor: MemoryViewDescriptor = {
         Ctor: Buffer,
@@ -311,7 +298,14 @@ function napi_create_buffer (
         runtimeAllocated: 1
       }
       emnapiExternalMemory.wasmMemoryViewTable.set(buffer, viewDescriptor)
-      emnapiExternalMemory.registry?.register(viewDescriptor, pointer)
+      if (pooled) {
+        viewDescriptor.pooled = true
+        // views re-created after memory growth share the descriptor,
+        // so the block is in use until the descriptor is collected
+        emnapiBufferPool.registry!.register(viewDescriptor, [pointer, size], viewDescriptor)
+      } else {
+        emnapiExternalMemory.registry?.register(viewDescriptor, pointer)
+      }
 
       value = emnapiCtx.addToCurrentScope(buffer).id
       $makeSetValue('result', 0, 'value', '*')
@@ -323,6 +317,45 @@ function napi_create_buffer (
   })
 }
 
+function napi_create_buffer (
+  env: napi_env,
+  size: size_t,
+  data: Pointer<Pointer<void>>,
+  result: Pointer<napi_value>
+): napi_status {
+  return emnapiCreateBuffer(env, size, data, result, true, 'napi_create_buffer')
+}
+
+function emnapi_create_buffer_unsafe (
+  env: napi_env,
+  size: size_t,
+  data: Pointer<Pointer<void>>,
+  result: Pointer<napi_value>
+): napi_status {
+  return emnapiCreateBuffer(env, size, data, result, false, 'emnapi_create_buffer_unsafe')
+}
+
+function emnapi_release_buffer (env: napi_env, value: napi_value): napi_status {
+  $CHECK_ENV!(env)
+  const envObject = emnapiCtx.envStore.get(env)!
+  $CHECK_ARG!(envObject, value)
+  const buffer = emnapiCtx.handleStore.getValue(value)
+  const descriptor = ArrayBuffer.isView(buffer) ? emnapiExternalMemory.wasmMemoryViewTable.get(buffer) : undefined
+  // Only pooled blocks. The JS buffer still views the memory, so the
+  // block is pinned to the pool instead of going back to malloc, other
+  // blocks are left to their finalizer.
+  if (descriptor === undefined || !descriptor.pooled) {
+    return envObject.setLastError(napi_status.napi_invalid_arg)
+  }
+  emnapiBufferPool.registry!.unregister(descriptor)
+  emnapiBufferPool.pin(descriptor.address, descriptor.length)
+  // other views of the block share the descriptor
+  descriptor.pooled = false
+  descriptor.address = 0
+  descriptor.length = 0
+  return envObject.clearLastError()
+}
+
 function napi_create_buffer_copy (
   env: napi_env,
   length: size_t,
@@ -452,7 +485,10 @@ emnapiImplementHelper('$emnapiCreateArrayBuffer', undefined, emnapiCreateArrayBu
 emnapiImplement('napi_create_array', 'ipp', napi_create_array)
 emnapiImplement('napi_create_array_with_length', 'ippp', napi_create_array_with_length)
 emnapiImplement('napi_create_arraybuffer', 'ipppp', napi_create_arraybuffer, ['$emnapiCreateArrayBuffer'])
-emnapiImplement('napi_create_buffer', 'ippp', napi_create_buffer, ['$emnapiExternalMemory', 'malloc'])
+emnapiImplementHelper('$emnapiCreateBuffer', undefined, emnapiCreateBuffer, ['$emnapiExternalMemory', '$emnapiBufferPool', 'malloc'])
+emnapiImplement('napi_create_buffer', 'ippp', napi_create_buffer, ['$emnapiCreateBuffer'])
+emnapiImplement2('emnapi_create_buffer_unsafe', 'ippp', emnapi_create_buffer_unsafe, ['$emnapiCreateBuffer'])
+emnapiImplement2('emnapi_release_buffer', 'ipp', emnapi_release_buffer, ['$emnapiExternalMemory', '$emnapiBufferPool'])
 emnapiImplement('napi_create_buffer_copy', 'ippppp', napi_create_buffer_copy, ['$emnapiCreateArrayBuffer'])
 emnapiImplement('napi_create_date', 'ipdp', napi_create_date)
 emnapiImplement('napi_create_external', 'ippppp', napi_create_external)
@@ -9,7 +9,7 @@ function napi_define_class (
   result: Pointer<napi_value>
 ): napi_status {
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
-  let propPtr: number, valueHandleId: number, attributes: number
+  let valueHandleId: number
 
   return $PREAMBLE!(env, (envObject) => {
     $CHECK_ARG!(envObject, result)
@@ -30,39 +30,8 @@ function napi_define_class (
     if (fresult.status !== napi_status.napi_ok) return envObject.setLastError(fresult.status)
     const F = fresult.f
 
-    let propertyName: string | symbol
-
-    for (let i = 0; i < property_count; i++) {
-      // eslint-disable-next-line @typescript-eslint/no-unused-vars
-      propPtr = properties + (i * ($POINTER_SIZE * 8))
-      const utf8Name = $makeGetValue('propPtr', 0, '*')
-      const name = $makeGetValue('propPtr', POINTER_SIZE, '*')
-      const method = $makeGetValue('propPtr', POINTER_SIZE * 2, '*')
-      const getter = $makeGetValue('propPtr', POINTER_SIZE * 3, '*')
-      const setter = $makeGetValue('propPtr', POINTER_SIZE * 4, '*')
-      const value = $makeGetValue('propPtr', POINTER_SIZE * 5, '*')
-      attributes = $makeGetValue('propPtr', POINTER_SIZE * 6, POINTER_WASM_TYPE) as number
-      $from64('attributes')
-      const data = $makeGetValue('propPtr', POINTER_SIZE * 7, '*')
-
-      if (utf8Name) {
-        propertyName = emnapiString.UTF8ToString(utf8Name, -1)
-      } else {
-        if (!name) {
-          return envObject.setLastError(napi_status.napi_name_expected)
-        }
-        propertyName = emnapiCtx.handleStore.get(name)!.value
-        if (typeof propertyName !== 'string' && typeof propertyName !== 'symbol') {
-          return envObject.setLastError(napi_status.napi_name_expected)
-        }
-      }
-
-      if ((attributes & napi_property_attributes.napi_static) !== 0) {
-        emnapiDefineProperty(envObject, F, propertyName, method, getter, setter, value, attributes, data)
-        continue
-      }
-      emnapiDefineProperty(envObject, F.prototype, propertyName, method, getter, setter, value, attributes, data)
-    }
+    const status = emnapiDefineProperties(envObject, F.prototype, F, LazyMethod.None, property_count, properties)
+    if (status !== napi_status.napi_ok) return envObject.setLastError(status)
 
     // eslint-disable-next-line @typescript-eslint/no-unused-vars
     const valueHandle = emnapiCtx.addToCurrentScope(F)
@@ -185,7 +154,7 @@ function _napi_add_finalizer (env: napi_env, js_object: napi_value, finalize_dat
   return envObject.clearLastError()
 }
 
-emnapiImplement('napi_define_class', 'ipppppppp', napi_define_class, ['$emnapiCreateFunction', '$emnapiDefineProperty', '$emnapiString'])
+emnapiImplement('napi_define_class', 'ipppppppp', napi_define_class, ['$emnapiCreateFunction', '$emnapiDefineProperties'])
 emnapiImplement('napi_wrap', 'ipppppp', napi_wrap, ['$emnapiWrap'])
 emnapiImplement('napi_unwrap', 'ippp', napi_unwrap, ['$emnapiUnwrap'])
 emnapiImplement('napi_remove_wrap', 'ippp', napi_remove_wrap, ['$emnapiUnwrap'])
@@ -254,6 +254,12 @@ class Transform {
         if (arr.length > 3) {
           arr[3] = this.ctx.factory.createIdentifier('undefined')
         }
+        if (this.defines.PROFILE &&
+          (functionName === 'emnapiImplement' || functionName === 'emnapiImplement2') &&
+          ts.isStringLiteral(arr[0]) && arr.length > 2
+        ) {
+          arr[2] = this.expandProfileWrap(arr[0], arr[2])
+        }
         return this.ctx.factory.updateCallExpression(
           node,
           node.expression,
@@ -297,6 +303,21 @@ class Transform {
     return ts.visitEachChild(node, this.visitor, this.ctx)
   }
 
+  expandProfileWrap (name: StringLiteral, impl: Expression): Expression {
+    const factory = this.ctx.factory
+    return factory.createCallExpression(
+      factory.createPropertyAccessExpression(
+        factory.createIdentifier('emnapiProfile'),
+        factory.createIdentifier('wrap')
+      ),
+      undefined,
+      [
+        factory.createStringLiteral(name.text),
+        impl
+      ]
+    )
+  }
+
   expandMakeGetValue (node: CallExpression): Expression {
     const callexp = node
     const argv0 = callexp.arguments[0]
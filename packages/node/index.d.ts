@@ -15,6 +15,7 @@ export declare namespace node {
   // export function openCallbackScope (resource: object, asyncContext: AsyncContext): bigint
   // export function closeCallbackScope (callbackScope: bigint): void
   export function makeCallback<P extends any[], T> (resource: object, cb: (...args: P) => T, argv: P, asyncContext: AsyncContext): T
+  export function adjustExternalMemory (changeInBytes: number): number
 }
 
 export declare namespace napi {
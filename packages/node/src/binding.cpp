@@ -85,6 +85,13 @@ void MakeCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
   args.GetReturnValue().Set(ret.FromMaybe(v8::Local<v8::Value>()));
 }
 
+void AdjustExternalMemory(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  int64_t change_in_bytes = static_cast<int64_t>(args[0].As<v8::Number>()->Value());
+  int64_t result = isolate->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+  args.GetReturnValue().Set(v8::Number::New(isolate, static_cast<double>(result)));
+}
+
 }
 
 NODE_MODULE_INIT() {
@@ -93,6 +100,7 @@ NODE_MODULE_INIT() {
   // NODE_SET_METHOD(exports, "openCallbackScope", OpenCallbackScope);
   // NODE_SET_METHOD(exports, "closeCallbackScope", CloseCallbackScope);
   NODE_SET_METHOD(exports, "makeCallback", MakeCallback);
+  NODE_SET_METHOD(exports, "adjustExternalMemory", AdjustExternalMemory);
 }
 
 }
@@ -14,6 +14,8 @@ import {
   _setImmediate,
   _Buffer,
   _MessageChannel,
+  typedArrayConstructors,
+  getTypedArrayType,
   version,
   NODE_API_SUPPORTED_VERSION_MAX,
   NAPI_VERSION_EXPERIMENTAL,
@@ -81,6 +83,50 @@ class CleanupQueue {
   }
 }
 
+export interface HandleStats {
+  /** Handles currently alive in any scope */
+  liveHandles: number
+  /** Highest `liveHandles` value observed */
+  peakHandles: number
+  /** Current handle scope nesting */
+  scopeDepth: number
+  /** Deepest handle scope nesting observed */
+  peakScopeDepth: number
+  /** Calls into the module (functions, finalizers, async callbacks) observed */
+  callbacks: number
+  /** Mean number of handles created during a call into the module, in any scope */
+  meanHandlesCreatedPerCallback: number
+  /** Maximum number of handles created during a call into the module, in any scope */
+  maxHandlesCreatedPerCallback: number
+}
+
+export interface ExternalMemoryStats {
+  /** Bytes currently reported through `napi_adjust_external_memory` by all envs */
+  current: number
+  /** Highest `current` value observed */
+  peak: number
+  /** Times the `drain` threshold was crossed */
+  finalizerDrains: number
+  /** Times the `gc` threshold was crossed */
+  gcRequests: number
+}
+
+export interface ExternalMemoryThresholds {
+  /** Drain pending finalizers every time an env's counter grows by this many bytes, `0` disables */
+  drain: number
+  /** Call `globalThis.gc()` (`--expose-gc`) every time an env's counter grows by this many bytes, `0` disables */
+  gc: number
+}
+
+export type HandleSoftLimitCallback = (live: number, limit: number, callbackName: string) => void
+
+function warnHandleSoftLimit (live: number, limit: number, callbackName: string): void {
+  console.warn(
+    `[emnapi] ${live} live handles reached the soft limit of ${limit} in native callback "${callbackName}". ` +
+    'Consider opening a handle scope inside long running loops.'
+  )
+}
+
 class NodejsWaitingRequestCounter {
   private readonly refHandle: { ref: () => void; unref: () => void }
   private count: number
@@ -119,6 +165,16 @@ export class Context {
   private readonly refCounter?: NodejsWaitingRequestCounter
   private readonly cleanupQueue: CleanupQueue
 
+  private _callbackCount = 0
+  private _callbackHandlesCreated = 0
+  private _callbackHandlesCreatedMax = 0
+
+  private _externalMemory = 0
+  private _externalMemoryPeak = 0
+  private _finalizerDrains = 0
+  private _gcRequests = 0
+  public externalMemoryThresholds: ExternalMemoryThresholds = { drain: 0, gc: 0 }
+
   public feature = {
     supportReflect,
     supportFinalizer,
@@ -128,7 +184,9 @@ export class Context {
     canSetFunctionName,
     setImmediate: _setImmediate,
     Buffer: _Buffer,
-    MessageChannel: _MessageChannel
+    MessageChannel: _MessageChannel,
+    typedArrayConstructors,
+    getTypedArrayType
   }
 
   public constructor () {
@@ -207,11 +265,96 @@ export class Context {
   }
 
   openScope (envObject: Env): HandleScope {
-    return this.scopeStore.openScope(envObject)
+    const scope = this.scopeStore.openScope(envObject)
+    scope.createdAtOpen = this.handleStore.created()
+    return scope
+  }
+
+  closeScope (envObject: Env, scope?: HandleScope): void {
+    // scope is only passed by the outermost scope of a call into the module,
+    // the count includes handles of inner scopes that were already closed
+    if (scope !== undefined) {
+      const count = this.handleStore.created() - scope.createdAtOpen
+      this._callbackCount++
+      this._callbackHandlesCreated += count
+      if (count > this._callbackHandlesCreatedMax) this._callbackHandlesCreatedMax = count
+    }
+    this.scopeStore.closeScope(envObject)
   }
 
-  closeScope (envObject: Env, _scope?: HandleScope): void {
-    this.scopeStore.closeScope(envObject)
+  public getHandleStats (): HandleStats {
+    const callbacks = this._callbackCount
+    return {
+      liveHandles: this.handleStore.size(),
+      peakHandles: this.handleStore.peak(),
+      scopeDepth: this.scopeStore.depth(),
+      peakScopeDepth: this.scopeStore.maxDepth,
+      callbacks,
+      meanHandlesCreatedPerCallback: callbacks === 0 ? 0 : this._callbackHandlesCreated / callbacks,
+      maxHandlesCreatedPerCallback: this._callbackHandlesCreatedMax
+    }
+  }
+
+  public resetHandleStats (): void {
+    this.handleStore.resetPeak()
+    this.scopeStore.maxDepth = this.scopeStore.depth()
+    this._callbackCount = 0
+    this._callbackHandlesCreated = 0
+    this._callbackHandlesCreatedMax = 0
+  }
+
+  /**
+   * Report when the number of live handles climbs to `limit`,
+   * along with the name of the native callback that is running.
+   * By default a warning is printed to the console. `0` disables the check.
+   */
+  public setHandleSoftLimit (limit: number, callback: HandleSoftLimitCallback = warnHandleSoftLimit): void {
+    const handleStore = this.handleStore
+    handleStore.setSoftLimit(limit)
+    if (limit > 0) {
+      handleStore.onSoftLimit = (live) => {
+        const info = this.cbinfoStack.current
+        callback(live, limit, info === null ? '<none>' : (info.fn.name || '<anonymous>'))
+      }
+    } else {
+      handleStore.onSoftLimit = null
+    }
+  }
+
+  public onExternalMemoryChange (change: number): void {
+    this._externalMemory += change
+    if (this._externalMemory > this._externalMemoryPeak) this._externalMemoryPeak = this._externalMemory
+  }
+
+  public onExternalMemoryPressure (drainFinalizers: boolean, requestGc: boolean): void {
+    if (drainFinalizers) this._finalizerDrains++
+    if (requestGc) this._gcRequests++
+  }
+
+  public getExternalMemoryStats (): ExternalMemoryStats {
+    return {
+      current: this._externalMemory,
+      peak: this._externalMemoryPeak,
+      finalizerDrains: this._finalizerDrains,
+      gcRequests: this._gcRequests
+    }
+  }
+
+  public resetExternalMemoryStats (): void {
+    this._externalMemoryPeak = this._externalMemory
+    this._finalizerDrains = 0
+    this._gcRequests = 0
+  }
+
+  /**
+   * Drain pending finalizers and / or request a GC when the external memory
+   * reported by an env grows by the given number of bytes. `0` disables a threshold.
+   */
+  public setExternalMemoryThresholds (thresholds: Partial<ExternalMemoryThresholds>): void {
+    this.externalMemoryThresholds = {
+      drain: thresholds.drain ?? 0,
+      gc: thresholds.gc ?? 0
+    }
   }
 
   ensureHandle<S> (value: S): Handle<S> {
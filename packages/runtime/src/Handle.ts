@@ -1,5 +1,5 @@
 import type { Env } from './env'
-import { isReferenceType, _global, _Buffer } from './util'
+import { isReferenceType, getTypedArrayType, _global, _Buffer } from './util'
 
 export class Handle<S> {
   public constructor (
@@ -44,7 +44,7 @@ export class Handle<S> {
   }
 
   public isTypedArray (): boolean {
-    return (ArrayBuffer.isView(this.value)) && !(this.value instanceof DataView)
+    return getTypedArrayType(this.value) !== -1
   }
 
   public isBuffer (): boolean {
@@ -106,6 +106,13 @@ export class HandleStore {
 
   public static MIN_ID = 6 as const
 
+  /**
+   * Backing arrays longer than this are trimmed once the live range
+   * falls below a quarter of their length, so a one-off spike
+   * does not pin its Handle objects for the lifetime of the context.
+   */
+  public static SHRINK_THRESHOLD = 65536
+
   private readonly _values: Array<Handle<any>> = [
     undefined!,
     HandleStore.UNDEFINED,
@@ -116,6 +123,11 @@ export class HandleStore {
   ]
 
   private _next: number = HandleStore.MIN_ID
+  private _peak: number = HandleStore.MIN_ID
+  private _limit: number = 0
+  private _created: number = 0
+
+  public onSoftLimit: ((live: number) => void) | null = null
 
   public push<S> (value: S): Handle<S> {
     let h: Handle<S>
@@ -128,7 +140,10 @@ export class HandleStore {
       h = new Handle(next, value)
       values[next] = h
     }
-    this._next++
+    this._created++
+    const live = ++this._next
+    if (live > this._peak) this._peak = live
+    if (live === this._limit && this.onSoftLimit !== null) this.onSoftLimit(live - HandleStore.MIN_ID)
     return h
   }
 
@@ -138,10 +153,68 @@ export class HandleStore {
     for (let i = start; i < end; ++i) {
       values[i].dispose()
     }
+    const length = values.length
+    if (length > HandleStore.SHRINK_THRESHOLD && start < (length >>> 2)) {
+      values.length = Math.max(start << 1, HandleStore.SHRINK_THRESHOLD)
+    }
+  }
+
+  /** Number of handles currently alive in any scope. */
+  public size (): number {
+    return this._next - HandleStore.MIN_ID
+  }
+
+  /** Highest number of simultaneously live handles since the last reset. */
+  public peak (): number {
+    return this._peak - HandleStore.MIN_ID
+  }
+
+  /** Number of handles created so far, including those already erased. */
+  public created (): number {
+    return this._created
+  }
+
+  public resetPeak (): void {
+    this._peak = this._next
+  }
+
+  /**
+   * Call `onSoftLimit` every time the live handle count climbs to `limit`.
+   * `0` disables the check.
+   */
+  public setSoftLimit (limit: number): void {
+    this._limit = limit > 0 ? limit + HandleStore.MIN_ID : 0
   }
 
   public get (id: Ptr): Handle<any> | undefined {
-    return this._values[id as any]
+    const h = this._values[id as any]
+    if (h !== undefined || !HandleStore.isImmediate(id)) return h
+    return new Handle(id as number, HandleStore.decodeImmediate(id as number))
+  }
+
+  /**
+   * The value of `id` without going through a `Handle`, immediate
+   * integers are decoded in place instead of allocating one.
+   */
+  public getValue (id: Ptr): any {
+    const h = this._values[id as any]
+    if (h !== undefined) return h.value
+    if (HandleStore.isImmediate(id)) return HandleStore.decodeImmediate(id as number)
+    return undefined
+  }
+
+  /**
+   * Whether `id` is a small integer encoded in the napi_value itself
+   * (bit 31 set, see EMNAPI_USE_IMMEDIATE_INTEGERS in emnapi_internal.h).
+   * Depending on how it was read from memory the value is either
+   * negative or above 2^31, `id | 0` handles both.
+   */
+  public static isImmediate (id: Ptr): boolean {
+    return typeof id === 'number' && (id | 0) < 0
+  }
+
+  public static decodeImmediate (id: number): number {
+    return (id << 1) >> 1
   }
 
   public swap (a: number, b: number): void {
@@ -156,5 +229,8 @@ export class HandleStore {
   public dispose (): void {
     this._values.length = HandleStore.MIN_ID
     this._next = HandleStore.MIN_ID
+    this._peak = HandleStore.MIN_ID
+    this._limit = 0
+    this.onSoftLimit = null
   }
 }
@@ -1,6 +1,6 @@
 import type { Env } from './env'
-import type { Handle, HandleStore } from './Handle'
-import { External } from './Handle'
+import type { Handle } from './Handle'
+import { External, HandleStore } from './Handle'
 
 export class HandleScope {
   public handleStore: HandleStore
@@ -10,6 +10,8 @@ export class HandleScope {
   public start: number
   public end: number
   public _escapeCalled: boolean
+  /** `HandleStore#created()` when the scope was opened */
+  public createdAtOpen: number
 
   public constructor (handleStore: HandleStore, id: number, parentScope: HandleScope | null, start: number, end = start) {
     this.handleStore = handleStore
@@ -20,6 +22,7 @@ export class HandleScope {
     this.start = start
     this.end = end
     this._escapeCalled = false
+    this.createdAtOpen = 0
   }
 
   public add<V> (value: V): Handle<V> {
@@ -46,6 +49,11 @@ export class HandleScope {
     if (this._escapeCalled) return null
     this._escapeCalled = true
 
+    // immediate values do not belong to any scope
+    if (HandleStore.isImmediate(handle)) {
+      return this.handleStore.get(handle)!
+    }
+
     if (handle < this.start || handle >= this.end) {
       return null
     }
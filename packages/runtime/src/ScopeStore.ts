@@ -5,10 +5,13 @@ import { HandleScope } from './HandleScope'
 export class ScopeStore {
   private readonly _rootScope: HandleScope
   public currentScope: HandleScope
+  /** Deepest handle scope nesting seen since the last reset. */
+  public maxDepth: number
 
   constructor () {
     this._rootScope = new HandleScope(null!, 0, null, 1, HandleStore.MIN_ID)
     this.currentScope = this._rootScope
+    this.maxDepth = 0
   }
 
   get (id: number): HandleScope | undefined {
@@ -34,6 +37,7 @@ export class ScopeStore {
       scope = new HandleScope(envObject.ctx.handleStore, currentScope.id + 1, currentScope, currentScope.end)
     }
     this.currentScope = scope
+    if (scope.id > this.maxDepth) this.maxDepth = scope.id
 
     envObject.openHandleScopes++
     return scope
@@ -47,6 +51,10 @@ export class ScopeStore {
     envObject.openHandleScopes--
   }
 
+  depth (): number {
+    return this.currentScope.id
+  }
+
   dispose (): void {
     let scope: HandleScope | null = this.currentScope
     while (scope !== null) {
@@ -61,5 +69,6 @@ export class ScopeStore {
       scope = child
     }
     this.currentScope = null!
+    this.maxDepth = 0
   }
 }
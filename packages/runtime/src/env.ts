@@ -3,6 +3,7 @@ import type { Context } from './Context'
 import type { IStoreValue } from './Store'
 import {
   TryCatch,
+  _global,
   _setImmediate,
   NODE_API_SUPPORTED_VERSION_MAX,
   NAPI_VERSION_EXPERIMENTAL,
@@ -48,12 +49,26 @@ export class Env implements IStoreValue {
 
   public pendingFinalizers: RefTracker[] = []
 
+  /** Bytes reported through `napi_adjust_external_memory` */
+  public externalMemory = 0
+  // `externalMemory` when the drain / gc threshold was last crossed
+  private _drainMark = 0
+  private _gcMark = 0
+  private _externalMemoryPressure = false
+
   public lastError = {
     errorCode: napi_status.napi_ok,
     engineErrorCode: 0 as uint32_t,
     engineReserved: 0 as Ptr
   }
 
+  /**
+   * Writes the last error to wasm memory. Set once the C side asked for
+   * its address, from then on the struct in memory is the only copy and
+   * `lastError` is no longer updated.
+   */
+  public syncLastError: ((errorCode: napi_status, engineErrorCode: uint32_t, engineReserved: void_p) => void) | null = null
+
   public constructor (
     public readonly ctx: Context,
     public moduleApiVersion: number,
@@ -93,6 +108,10 @@ export class Env implements IStoreValue {
   }
 
   public clearLastError (): napi_status {
+    if (this.syncLastError !== null) {
+      this.syncLastError(napi_status.napi_ok, 0, 0)
+      return napi_status.napi_ok
+    }
     const lastError = this.lastError
     if (lastError.errorCode !== napi_status.napi_ok) lastError.errorCode = napi_status.napi_ok
     if (lastError.engineErrorCode !== 0) lastError.engineErrorCode = 0
@@ -102,6 +121,10 @@ export class Env implements IStoreValue {
   }
 
   public setLastError (error_code: napi_status, engine_error_code: uint32_t = 0, engine_reserved: void_p = 0): napi_status {
+    if (this.syncLastError !== null) {
+      this.syncLastError(error_code, engine_error_code, engine_reserved)
+      return error_code
+    }
     const lastError = this.lastError
     if (lastError.errorCode !== error_code) lastError.errorCode = error_code
     if (lastError.engineErrorCode !== engine_error_code) lastError.engineErrorCode = engine_error_code
@@ -155,12 +178,66 @@ export class Env implements IStoreValue {
     }
   }
 
+  /**
+   * Account `change` bytes of native memory owned by JS objects of this env.
+   * Once the counter has grown by the thresholds set with
+   * `Context.setExternalMemoryThresholds` since they were last crossed,
+   * pending finalizers are drained and / or a GC is requested
+   * as soon as the current call into the module returns.
+   * @virtual
+   */
+  public adjustExternalMemory (change: number): number {
+    const before = this.externalMemory
+    const value = Math.max(0, before + change)
+    this.externalMemory = value
+    this.ctx.onExternalMemoryChange(value - before)
+
+    if (value < this._drainMark) this._drainMark = value
+    if (value < this._gcMark) this._gcMark = value
+    const { drain, gc } = this.ctx.externalMemoryThresholds
+    let drainFinalizers = false
+    let requestGc = false
+    if (drain > 0 && value - this._drainMark >= drain) {
+      this._drainMark = value
+      drainFinalizers = true
+    }
+    if (gc > 0 && value - this._gcMark >= gc) {
+      this._gcMark = value
+      requestGc = true
+    }
+    if ((drainFinalizers || requestGc) && !this._externalMemoryPressure) {
+      this._externalMemoryPressure = true
+      this.ctx.onExternalMemoryPressure(drainFinalizers, requestGc)
+      const run = (): void => {
+        this._externalMemoryPressure = false
+        if (requestGc && typeof (_global as any).gc === 'function') {
+          (_global as any).gc()
+        }
+        if (drainFinalizers && this.id !== 0) {
+          this.drainFinalizerQueue()
+        }
+      }
+      if (typeof Promise === 'function') {
+        Promise.resolve().then(run)
+      } else {
+        _setImmediate(run)
+      }
+    }
+    return value
+  }
+
+  /** @virtual */
+  public drainFinalizerQueue (): void {}
+
   /** @virtual */
   public deleteMe (): void {
     RefBase.finalizeAll(this.finalizing_reflist)
     RefBase.finalizeAll(this.reflist)
+    this.ctx.onExternalMemoryChange(-this.externalMemory)
+    this.externalMemory = 0
 
     this.tryCatch.extractException()
+    this.syncLastError = null
     this.ctx.envStore.remove(this.id)
   }
 
@@ -293,7 +370,17 @@ export class NodeEnv extends Env {
     }
   }
 
-  public drainFinalizerQueue (): void {
+  public override adjustExternalMemory (change: number): number {
+    const before = this.externalMemory
+    const value = super.adjustExternalMemory(change)
+    // let V8 weigh the JS wrappers of native memory too
+    if (this.nodeBinding && typeof this.nodeBinding.node.adjustExternalMemory === 'function' && value !== before) {
+      this.nodeBinding.node.adjustExternalMemory(value - before)
+    }
+    return value
+  }
+
+  public override drainFinalizerQueue (): void {
     while (this.pendingFinalizers.length > 0) {
       const refTracker = this.pendingFinalizers.shift()!
       refTracker.finalize()
@@ -1,5 +1,5 @@
 export { CallbackInfo, CallbackInfoStack } from './CallbackInfo'
-export { createContext, getDefaultContext, Context, type CleanupHookCallbackFunction } from './Context'
+export { createContext, getDefaultContext, Context, type CleanupHookCallbackFunction, type HandleStats, type HandleSoftLimitCallback, type ExternalMemoryStats, type ExternalMemoryThresholds } from './Context'
 export { Deferred, type IDeferrdValue } from './Deferred'
 export { Env, NodeEnv, type IReferenceBinding } from './env'
 export { EmnapiError, NotSupportWeakRefError, NotSupportBigIntError, NotSupportBufferError } from './errors'
@@ -15,6 +15,7 @@ export { Store, type IStoreValue } from './Store'
 
 export {
   isReferenceType,
+  getTypedArrayType,
   TryCatch,
   version,
   NODE_API_SUPPORTED_VERSION_MIN,
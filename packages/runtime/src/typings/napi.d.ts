@@ -2,6 +2,7 @@ declare type napi_env = Pointer<unknown>
 
 declare type napi_value = Pointer<unknown>
 declare type napi_ref = Pointer<unknown>
+declare type emnapi_prepared_call = Pointer<unknown>
 declare type napi_deferred = Pointer<unknown>
 declare type napi_handle_scope = Pointer<unknown>
 declare type napi_escapable_handle_scope = Pointer<unknown>
@@ -169,6 +170,11 @@ declare const enum emnapi_memory_view_type {
   emnapi_buffer = -2
 }
 
+declare const enum emnapi_prepared_args_type {
+  emnapi_prepared_args_double,
+  emnapi_prepared_args_int32
+}
+
 declare const enum napi_threadsafe_function_call_mode {
   napi_tsfn_nonblocking,
   napi_tsfn_blocking
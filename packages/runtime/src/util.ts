@@ -90,6 +90,59 @@ export function isReferenceType (v: any): v is object {
   return (typeof v === 'object' && v !== null) || typeof v === 'function'
 }
 
+type TypedArrayConstructor = { new (...args: any[]): ArrayBufferView; BYTES_PER_ELEMENT: number; name: string }
+
+/** Indexed by napi_typedarray_type, BigInt arrays are undefined where unsupported. */
+export const typedArrayConstructors: ReadonlyArray<TypedArrayConstructor | undefined> = [
+  Int8Array,
+  Uint8Array,
+  Uint8ClampedArray,
+  Int16Array,
+  Uint16Array,
+  Int32Array,
+  Uint32Array,
+  Float32Array,
+  Float64Array,
+  typeof BigInt64Array === 'function' ? BigInt64Array : undefined,
+  typeof BigUint64Array === 'function' ? BigUint64Array : undefined
+]
+
+const typedArrayTypes: Record<string, number> = /*#__PURE__*/ (function () {
+  const types: Record<string, number> = Object.create(null)
+  for (let i = 0; i < typedArrayConstructors.length; ++i) {
+    const Ctor = typedArrayConstructors[i]
+    if (Ctor !== undefined) types[Ctor.name] = i
+  }
+  return types
+})()
+
+// %TypedArray%.prototype[Symbol.toStringTag] returns the constructor name
+// of any typed array (including subclasses such as Buffer) and undefined
+// for everything else, so one getter call and one table lookup replace
+// a chain of instanceof checks
+const typedArrayTag: ((this: any) => string | undefined) | undefined = (typeof Symbol === 'function' && typeof Symbol.toStringTag === 'symbol')
+  ? Object.getOwnPropertyDescriptor(Object.getPrototypeOf(Int8Array.prototype), Symbol.toStringTag)?.get
+  : undefined
+
+/**
+ * The napi_typedarray_type of `value`, or `-1` if it is not a typed array
+ * Node-API knows about. The only typed array classifier, `Handle#isTypedArray`
+ * and the emnapi library both go through it.
+ */
+export function getTypedArrayType (value: any): number {
+  if (typedArrayTag !== undefined) {
+    const tag = typedArrayTag.call(value)
+    if (tag === undefined) return -1
+    const type = typedArrayTypes[tag]
+    return type === undefined ? -1 : type
+  }
+  for (let i = 0; i < typedArrayConstructors.length; ++i) {
+    const Ctor = typedArrayConstructors[i]
+    if (Ctor !== undefined && value instanceof Ctor) return i
+  }
+  return -1
+}
+
 const _require = /*#__PURE__*/ (function () {
   let nativeRequire
 
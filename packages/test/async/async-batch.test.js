@@ -0,0 +1,3 @@
+'use strict'
+process.env.EMNAPI_TEST_ASYNC_BATCH = '1'
+module.exports = require('./async.test.js')
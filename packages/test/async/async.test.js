@@ -5,8 +5,12 @@ const common = require('../common')
 const assert = require('assert')
 const child_process = require('child_process')
 
+// async-batch.test.js runs the same tests against the
+// EMNAPI_ASYNC_WORK_BATCH_COMPLETE build
+const target = process.env.EMNAPI_TEST_ASYNC_BATCH ? 'async_batch' : 'async'
+
 async function main () {
-  const loadPromise = load('async')
+  const loadPromise = load(target)
   const test_async = await loadPromise
 
   const testException = 'test_async_cb_exception'
@@ -91,6 +95,53 @@ async function main () {
     }))
   })
 
+  await new Promise((resolve) => {
+    // A completion that throws does not stop the others.
+    process.once('uncaughtException', common.mustCall(function (err) {
+      assert.strictEqual(err.message, 'batch 0')
+    }))
+    const seen = []
+    test_async.QueueBatch(3, common.mustCall(function (index) {
+      seen.push(index)
+      if (seen.length === 3) {
+        assert.deepStrictEqual(seen.sort(), [0, 1, 2])
+        setImmediate(resolve)
+      }
+      if (index === 0) {
+        throw new Error('batch 0')
+      }
+    }, 3))
+  })
+
+  await new Promise((resolve) => {
+    // A completion that queues its own work again.
+    test_async.Requeue(10, common.mustCall(function (count) {
+      assert.strictEqual(count, 10)
+      resolve()
+    }))
+  })
+
+  // More works than workers, so slots of the dispatch ring are reused
+  // while other works are still running.
+  for (let round = 0; round < 20; round++) {
+    await new Promise((resolve) => {
+      test_async.Stress(common.mustCall(function (errors) {
+        assert.strictEqual(errors, 0)
+        resolve()
+      }))
+    })
+  }
+
+  // A second instance has its own env, completions of both
+  // arrive in the same turn of the event loop.
+  const other = await load(target)
+  await Promise.all([test_async, other].map((binding) => new Promise((resolve) => {
+    binding.Requeue(3, common.mustCall(function (count) {
+      assert.strictEqual(count, 3)
+      resolve()
+    }))
+  })))
+
   process.exitCode = 0
 }
 
@@ -228,11 +228,176 @@ static napi_value DoRepeatedWork(napi_env env, napi_callback_info info) {
   return NULL;
 }
 
+// works whose complete callback calls back into JS, used to check that one
+// completion throwing or re-queueing its work does not disturb the others
+#define MAX_SLOTS 8
+
+typedef struct {
+  napi_ref ref;
+  napi_async_work work;
+  int32_t index;
+  int32_t remaining;
+  int32_t count;
+} slot_info;
+
+static slot_info slots[MAX_SLOTS];
+
+static slot_info* AcquireSlot(void) {
+  for (int i = 0; i < MAX_SLOTS; i++) {
+    if (slots[i].ref == NULL && slots[i].work == NULL) return &slots[i];
+  }
+  return NULL;
+}
+
+static void ReleaseSlot(napi_env env, slot_info* slot) {
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, slot->work));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, slot->ref));
+  slot->work = NULL;
+  slot->ref = NULL;
+}
+
+static void SlotExecute(napi_env env, void* data) {}
+
+static void BatchComplete(napi_env env, napi_status status, void* data) {
+  slot_info* slot = (slot_info*)(data);
+  napi_value cb, index;
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, slot->ref, &cb));
+  NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, slot->index, &index));
+  ReleaseSlot(env, slot);
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, cb, cb, 1, &index, NULL));
+}
+
+// creates all works first so that they are queued back to back
+static napi_value QueueBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], name;
+  slot_info* batch[MAX_SLOTS];
+  int32_t count;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_int32(env, argv[0], &count));
+  NAPI_ASSERT(env, count > 0 && count <= MAX_SLOTS, "Wrong number of works");
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, "Batch Work", NAPI_AUTO_LENGTH, &name));
+  for (int32_t i = 0; i < count; i++) {
+    slot_info* slot = AcquireSlot();
+    NAPI_ASSERT(env, slot != NULL, "Too many works in flight");
+    slot->index = i;
+    NAPI_CALL(env, napi_create_reference(env, argv[1], 1, &slot->ref));
+    NAPI_CALL(env, napi_create_async_work(env, NULL, name, SlotExecute,
+        BatchComplete, slot, &slot->work));
+    batch[i] = slot;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    NAPI_CALL(env, napi_queue_async_work(env, batch[i]->work));
+  }
+  return NULL;
+}
+
+static void RequeueComplete(napi_env env, napi_status status, void* data) {
+  slot_info* slot = (slot_info*)(data);
+  napi_value cb, count;
+  slot->count++;
+  if (--slot->remaining > 0) {
+    NAPI_CALL_RETURN_VOID(env, napi_queue_async_work(env, slot->work));
+    return;
+  }
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, slot->ref, &cb));
+  NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, slot->count, &count));
+  slot->count = 0;
+  ReleaseSlot(env, slot);
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, cb, cb, 1, &count, NULL));
+}
+
+static napi_value Requeue(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], name;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  slot_info* slot = AcquireSlot();
+  NAPI_ASSERT(env, slot != NULL, "Too many works in flight");
+  NAPI_CALL(env, napi_get_value_int32(env, argv[0], &slot->remaining));
+  NAPI_ASSERT(env, slot->remaining > 0, "Expected a positive count");
+  slot->count = 0;
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, "Requeued Work", NAPI_AUTO_LENGTH, &name));
+  NAPI_CALL(env, napi_create_reference(env, argv[1], 1, &slot->ref));
+  NAPI_CALL(env, napi_create_async_work(env, NULL, name, SlotExecute,
+      RequeueComplete, slot, &slot->work));
+  NAPI_CALL(env, napi_queue_async_work(env, slot->work));
+  return NULL;
+}
+
+// many more works than threads in the pool, every work checks that its
+// own execute callback ran exactly once
+#define STRESS_COUNT 64
+
+typedef struct {
+  napi_async_work work;
+  int32_t index;
+  int32_t executed;
+  int32_t output;
+} stress_info;
+
+static stress_info stress_works[STRESS_COUNT];
+static int32_t stress_pending;
+static int32_t stress_errors;
+static napi_ref stress_ref;
+
+static void StressExecute(napi_env env, void* data) {
+  stress_info* w = (stress_info*)(data);
+  // uneven run times so that workers claim jobs out of step
+  for (volatile int32_t i = 0; i < (w->index % 7) * 1000; i++) {}
+  w->executed++;
+  w->output = w->index * 2;
+}
+
+static void StressComplete(napi_env env, napi_status status, void* data) {
+  stress_info* w = (stress_info*)(data);
+  napi_value cb, errors;
+  if (status != napi_ok || w->executed != 1 || w->output != w->index * 2) {
+    stress_errors++;
+  }
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, w->work));
+  w->work = NULL;
+  if (--stress_pending > 0) return;
+
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, stress_ref, &cb));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, stress_ref));
+  stress_ref = NULL;
+  NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, stress_errors, &errors));
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, cb, cb, 1, &errors, NULL));
+}
+
+static napi_value Stress(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], name;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_ASSERT(env, stress_pending == 0, "Previous run is still going");
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, "Stress Work", NAPI_AUTO_LENGTH, &name));
+  NAPI_CALL(env, napi_create_reference(env, argv[0], 1, &stress_ref));
+  stress_errors = 0;
+  for (int32_t i = 0; i < STRESS_COUNT; i++) {
+    stress_works[i].index = i;
+    stress_works[i].executed = 0;
+    stress_works[i].output = 0;
+    NAPI_CALL(env, napi_create_async_work(env, NULL, name, StressExecute,
+        StressComplete, &stress_works[i], &stress_works[i].work));
+  }
+  stress_pending = STRESS_COUNT;
+  for (int32_t i = 0; i < STRESS_COUNT; i++) {
+    NAPI_CALL(env, napi_queue_async_work(env, stress_works[i].work));
+  }
+  return NULL;
+}
+
 static napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor properties[] = {
     DECLARE_NAPI_PROPERTY("Test", Test),
     DECLARE_NAPI_PROPERTY("TestCancel", TestCancel),
     DECLARE_NAPI_PROPERTY("DoRepeatedWork", DoRepeatedWork),
+    DECLARE_NAPI_PROPERTY("QueueBatch", QueueBatch),
+    DECLARE_NAPI_PROPERTY("Requeue", Requeue),
+    DECLARE_NAPI_PROPERTY("Stress", Stress),
   };
 
   NAPI_CALL(env, napi_define_properties(
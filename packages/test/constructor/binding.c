@@ -168,6 +168,10 @@ napi_value Init(napi_env env, napi_value exports) {
 
   napi_property_descriptor properties[] = {
     { "echo", NULL, Echo, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "configurableEcho", NULL, Echo, NULL, NULL, NULL,
+        napi_writable | napi_configurable, NULL },
+    { "configurableEcho2", NULL, Echo, NULL, NULL, NULL,
+        napi_writable | napi_configurable, NULL },
     { "readwriteValue", NULL, NULL, NULL, NULL, number,
         napi_enumerable | napi_writable, NULL },
     { "readonlyValue", NULL, NULL, NULL, NULL, number, napi_enumerable,
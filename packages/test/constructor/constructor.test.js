@@ -51,6 +51,24 @@ module.exports = load('constructor').then(TestConstructor => {
   assert.strictEqual(TestConstructor.staticReadonlyAccessor1, 10)
   assert.strictEqual(test_object.staticReadonlyAccessor1, undefined)
 
+  // napi_define_class creates every method up front
+  assert.strictEqual(typeof Object.getOwnPropertyDescriptor(TestConstructor.prototype, 'configurableEcho2').value, 'function')
+
+  // Configurable methods behave like plain methods
+  assert.strictEqual(test_object.configurableEcho('hello'), 'hello')
+  assert.strictEqual(test_object.configurableEcho, TestConstructor.prototype.configurableEcho)
+  const echoDescriptor = Object.getOwnPropertyDescriptor(TestConstructor.prototype, 'configurableEcho')
+  assert.strictEqual(typeof echoDescriptor.value, 'function')
+  assert.strictEqual(echoDescriptor.writable, true)
+  assert.strictEqual(echoDescriptor.enumerable, false)
+  assert.strictEqual(echoDescriptor.configurable, true)
+  const other_object = new TestConstructor()
+  const replacement = () => 'replaced'
+  other_object.configurableEcho2 = replacement
+  assert.strictEqual(other_object.configurableEcho2, replacement)
+  assert.strictEqual(test_object.configurableEcho2('hello'), 'hello')
+  assert.ok(!propertyNames.includes('configurableEcho'))
+
   // Verify that passing NULL to napi_define_class() results in the correct
   // error.
   assert.deepStrictEqual(TestConstructor.TestDefineClass(), {
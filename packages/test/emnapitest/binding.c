@@ -1,7 +1,7 @@
 #ifdef __EMSCRIPTEN__
 #include <stdio.h>
 #endif
-#include "js_native_api.h"
+#include "node_api.h"
 #include "emnapi.h"
 #include "../common.h"
 
@@ -99,6 +99,181 @@ static napi_value NullArrayBuffer(napi_env env, napi_callback_info info) {
   return output_view;
 }
 
+static napi_value ArrayBufferBytes(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc == 1, "Wrong number of arguments");
+
+  uint8_t* data;
+  size_t size;
+  NAPI_CALL(env, napi_get_arraybuffer_info(env, args[0], (void**) &data, &size));
+
+  napi_value ret, element;
+  NAPI_CALL(env, napi_create_array_with_length(env, size, &ret));
+  for (size_t i = 0; i < size; ++i) {
+    NAPI_CALL(env, napi_create_uint32(env, data[i], &element));
+    NAPI_CALL(env, napi_set_element(env, ret, i, element));
+  }
+  return ret;
+}
+
+static napi_value PreparedCall(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+  NAPI_ASSERT(env, argc == 2, "Wrong number of arguments");
+
+  napi_ref ref;
+  NAPI_CALL(env, napi_create_reference(env, args[0], 1, &ref));
+  emnapi_prepared_call call;
+  NAPI_CALL(env, emnapi_prepare_call(env, ref, args[1], 3, &call));
+
+  napi_value ret, element, argv[3];
+  NAPI_CALL(env, napi_create_array_with_length(env, 3, &ret));
+
+  NAPI_CALL(env, napi_create_int32(env, 1, &argv[0]));
+  NAPI_CALL(env, napi_create_int32(env, 2, &argv[1]));
+  NAPI_CALL(env, napi_create_int32(env, 3, &argv[2]));
+  NAPI_CALL(env, emnapi_call_prepared(env, call, argv, &element));
+  NAPI_CALL(env, napi_set_element(env, ret, 0, element));
+
+  void* area;
+  NAPI_CALL(env, emnapi_prepared_call_get_args(env, call, &area));
+  double* doubles = (double*) area;
+  doubles[0] = 0.5;
+  doubles[1] = 1.5;
+  doubles[2] = 2.5;
+  NAPI_CALL(env, emnapi_call_prepared_args(env, call, emnapi_prepared_args_double, &element));
+  NAPI_CALL(env, napi_set_element(env, ret, 1, element));
+
+  int32_t* ints = (int32_t*) area;
+  ints[0] = -1;
+  ints[1] = 10;
+  ints[2] = 100;
+  NAPI_CALL(env, emnapi_call_prepared_args(env, call, emnapi_prepared_args_int32, &element));
+  NAPI_CALL(env, napi_set_element(env, ret, 2, element));
+
+  NAPI_CALL(env, emnapi_release_prepared_call(env, call));
+  NAPI_ASSERT(env, emnapi_prepared_call_get_args(env, call, &area) == napi_invalid_arg,
+              "released call has no arguments");
+  NAPI_ASSERT(env, emnapi_call_prepared(env, call, argv, &element) == napi_invalid_arg,
+              "released call can not be called");
+  NAPI_ASSERT(env, emnapi_call_prepared_args(env, call, emnapi_prepared_args_int32, &element) == napi_invalid_arg,
+              "released call can not be called");
+  NAPI_ASSERT(env, emnapi_release_prepared_call(env, call) == napi_invalid_arg,
+              "released call can not be released again");
+  NAPI_CALL(env, napi_delete_reference(env, ref));
+  return ret;
+}
+
+static napi_value LazyEcho(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+  return arg;
+}
+
+static napi_value DefineLazyProperties(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value obj, value;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &obj, NULL, NULL));
+  NAPI_CALL(env, napi_create_int32(env, 42, &value));
+
+  napi_property_descriptor descriptors[] = {
+    { "echo", NULL, LazyEcho, NULL, NULL, NULL,
+        napi_enumerable | napi_writable | napi_configurable, NULL },
+    { "fixedEcho", NULL, LazyEcho, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "value", NULL, NULL, NULL, NULL, value, napi_enumerable, NULL },
+  };
+  NAPI_CALL(env, emnapi_define_lazy_properties(
+      env, obj, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+  return obj;
+}
+
+static napi_value HeapStatistics(napi_env env, napi_callback_info info) {
+  // leave a large free block behind
+  void* p = malloc(1024 * 1024);
+  NAPI_ASSERT(env, p != NULL, "malloc failed");
+  free(p);
+
+  emnapi_heap_statistics stats;
+  NAPI_CALL(env, emnapi_get_heap_statistics(env, &stats));
+
+  double values[] = {
+    (double) stats.memory_size,
+    (double) stats.heap_size,
+    (double) stats.used_size,
+    (double) stats.free_size,
+    (double) stats.largest_free_size,
+    (double) stats.free_page_size
+  };
+  napi_value result, value;
+  NAPI_CALL(env, napi_create_array_with_length(env, 6, &result));
+  for (uint32_t i = 0; i < 6; ++i) {
+    NAPI_CALL(env, napi_create_double(env, values[i], &value));
+    NAPI_CALL(env, napi_set_element(env, result, i, value));
+  }
+  return result;
+}
+
+static napi_value BufferPool(napi_env env, napi_callback_info info) {
+  napi_value a, b, c;
+  void *pa, *pb, *pc;
+  NAPI_CALL(env, napi_create_buffer(env, 100, &pa, &a));
+  for (int i = 0; i < 100; ++i) ((uint8_t*) pa)[i] = 0xff;
+  NAPI_CALL(env, emnapi_release_buffer(env, a));
+  NAPI_ASSERT(env, emnapi_release_buffer(env, a) == napi_invalid_arg,
+              "releasing twice should fail");
+
+  // the released block is reused and zero filled
+  NAPI_CALL(env, napi_create_buffer(env, 100, &pb, &b));
+  NAPI_ASSERT(env, pb == pa, "the released block should be reused");
+  for (int i = 0; i < 100; ++i) {
+    NAPI_ASSERT(env, ((uint8_t*) pb)[i] == 0, "napi_create_buffer should zero fill");
+  }
+  for (int i = 0; i < 100; ++i) ((uint8_t*) pb)[i] = 0xab;
+  NAPI_CALL(env, emnapi_release_buffer(env, b));
+
+  // unless asked not to
+  NAPI_CALL(env, emnapi_create_buffer_unsafe(env, 100, &pc, &c));
+  NAPI_ASSERT(env, pc == pa, "the released block should be reused");
+  NAPI_ASSERT(env, ((uint8_t*) pc)[99] == 0xab, "emnapi_create_buffer_unsafe should not fill");
+  return c;
+}
+
+static napi_value CreateBuffer(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], result;
+  uint32_t size;
+  void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &size));
+  NAPI_CALL(env, napi_create_buffer(env, size, &data, &result));
+  for (uint32_t i = 0; i < size; ++i) ((uint8_t*) data)[i] = 0x5a;
+  return result;
+}
+
+static napi_value BufferAddress(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], buffer, result;
+  uint32_t size;
+  void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &size));
+  NAPI_CALL(env, napi_create_buffer(env, size, &data, &buffer));
+  NAPI_CALL(env, napi_create_double(env, (double) (uintptr_t) data, &result));
+  return result;
+}
+
+static napi_value ReleaseBuffer(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], result;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_create_int32(env, emnapi_release_buffer(env, argv[0]), &result));
+  return result;
+}
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
 #ifdef __EMSCRIPTEN__
@@ -115,6 +290,14 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("External", External),
     DECLARE_NAPI_PROPERTY("NullArrayBuffer", NullArrayBuffer),
     DECLARE_NAPI_PROPERTY("GrowMemory", GrowMemory),
+    DECLARE_NAPI_PROPERTY("ArrayBufferBytes", ArrayBufferBytes),
+    DECLARE_NAPI_PROPERTY("PreparedCall", PreparedCall),
+    DECLARE_NAPI_PROPERTY("DefineLazyProperties", DefineLazyProperties),
+    DECLARE_NAPI_PROPERTY("HeapStatistics", HeapStatistics),
+    DECLARE_NAPI_PROPERTY("BufferPool", BufferPool),
+    DECLARE_NAPI_PROPERTY("CreateBuffer", CreateBuffer),
+    DECLARE_NAPI_PROPERTY("BufferAddress", BufferAddress),
+    DECLARE_NAPI_PROPERTY("ReleaseBuffer", ReleaseBuffer),
   };
 
   NAPI_CALL(env, napi_define_properties(
@@ -7,7 +7,7 @@ const { load } = require('../util')
 
 const promise = load('emnapitest')
 
-module.exports = promise.then(test_typedarray => {
+module.exports = promise.then(async test_typedarray => {
   if (!process.env.EMNAPI_TEST_WASI && !process.env.EMNAPI_TEST_WASM32) {
     const mod = test_typedarray.getModuleObject()
 
@@ -20,7 +20,30 @@ module.exports = promise.then(test_typedarray => {
   let externalResult = test_typedarray.External()
   assert.ok(externalResult instanceof Uint8Array)
   assert.deepStrictEqual([...externalResult], [0, 1, 2])
+
+  const api = (process.env.EMNAPI_TEST_WASI || process.env.EMNAPI_TEST_WASM32)
+    ? promise.Module.emnapi
+    : {
+        syncMemory: promise.Module.emnapiSyncMemory,
+        createMemoryViewRef: promise.Module.emnapiCreateMemoryViewRef,
+        onMemoryGrow: promise.Module.emnapiOnMemoryGrow,
+        trackArrayBuffer: promise.Module.emnapiTrackArrayBuffer,
+        setMirrorCopyOnce: promise.Module.emnapiSetMirrorCopyOnce,
+        getMirrorStats: promise.Module.emnapiGetMirrorStats
+      }
+  const viewRef = api.createMemoryViewRef(externalResult)
+  const growEvents = []
+  const removeListener = api.onMemoryGrow((e) => { growEvents.push(e) })
+
   test_typedarray.GrowMemory()
+
+  // reported when the memory grows, not when a view is next looked up
+  assert.strictEqual(growEvents.length, 1)
+  assert.ok(growEvents[0].newByteLength > growEvents[0].oldByteLength)
+  assert.deepStrictEqual([...viewRef.view], [0, 1, 2])
+  assert.notStrictEqual(viewRef.view.buffer.byteLength, 0)
+  assert.strictEqual(growEvents.length, 1)
+  removeListener()
   if (process.env.EMNAPI_TEST_WASI || process.env.EMNAPI_TEST_WASM32) {
     console.log(promise.Module.emnapi)
     externalResult = promise.Module.emnapi.syncMemory(false, externalResult)
@@ -29,6 +52,125 @@ module.exports = promise.then(test_typedarray => {
   }
   assert.deepStrictEqual([...externalResult], [0, 1, 2])
 
+  // mirrors of JS ArrayBuffers
+  const ab = new ArrayBuffer(4)
+  const u8 = new Uint8Array(ab).fill(1)
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab), [1, 1, 1, 1])
+  assert.deepStrictEqual(api.getMirrorStats(ab), { copies: 1, copiedBytes: 4 })
+  const tracker = api.trackArrayBuffer(ab)
+  u8[1] = 7
+  tracker.markDirty(1, 1)
+  u8[2] = 9
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab), [1, 7, 1, 1])
+  assert.deepStrictEqual(api.getMirrorStats(ab), { copies: 2, copiedBytes: 5 })
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab), [1, 7, 1, 1])
+  assert.deepStrictEqual(api.getMirrorStats(ab), { copies: 2, copiedBytes: 5 })
+
+  api.setMirrorCopyOnce(true)
+  const ab2 = new ArrayBuffer(2)
+  const u8b = new Uint8Array(ab2).fill(3)
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab2), [3, 3])
+  u8b.fill(4)
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab2), [3, 3])
+  api.syncMemory(true, ab2)
+  assert.deepStrictEqual(test_typedarray.ArrayBufferBytes(ab2), [4, 4])
+  assert.deepStrictEqual(api.getMirrorStats(ab2), { copies: 2, copiedBytes: 4 })
+  api.setMirrorCopyOnce(false)
+
+  const recv = { base: 1000 }
+  assert.deepStrictEqual(test_typedarray.PreparedCall(function (a, b, c) {
+    assert.strictEqual(this, recv)
+    assert.strictEqual(arguments.length, 3)
+    return this.base + a + b + c
+  }, recv), [1006, 1004.5, 1109])
+
+  const lazy = test_typedarray.DefineLazyProperties({})
+  assert.deepStrictEqual(Object.keys(lazy), ['echo', 'fixedEcho', 'value'])
+  assert.strictEqual(typeof Object.getOwnPropertyDescriptor(lazy, 'echo').get, 'function')
+  // non-configurable methods are created up front
+  const fixedDescriptor = Object.getOwnPropertyDescriptor(lazy, 'fixedEcho')
+  assert.strictEqual(typeof fixedDescriptor.value, 'function')
+  assert.strictEqual(fixedDescriptor.configurable, false)
+  assert.strictEqual(lazy.value, 42)
+  assert.strictEqual(lazy.echo('lazy'), 'lazy')
+  const echoDescriptor = Object.getOwnPropertyDescriptor(lazy, 'echo')
+  assert.strictEqual(typeof echoDescriptor.value, 'function')
+  assert.strictEqual(echoDescriptor.writable, true)
+  assert.strictEqual(echoDescriptor.enumerable, true)
+  assert.strictEqual(echoDescriptor.configurable, true)
+  assert.strictEqual(lazy.echo, echoDescriptor.value)
+
+  // freezing before the first access keeps the accessor working
+  const frozen = Object.freeze(test_typedarray.DefineLazyProperties({}))
+  const frozenEcho = frozen.echo
+  assert.strictEqual(typeof frozenEcho, 'function')
+  assert.strictEqual(frozen.echo, frozenEcho)
+  assert.strictEqual(frozen.echo('frozen'), 'frozen')
+  assert.strictEqual(typeof Object.getOwnPropertyDescriptor(frozen, 'echo').get, 'function')
+  assert.throws(() => { frozen.echo = null }, TypeError)
+  assert.strictEqual(frozen.echo, frozenEcho)
+  assert.ok(Object.isFrozen(frozen))
+
+  const pooled = test_typedarray.BufferPool()
+  assert.ok(Buffer.isBuffer(pooled))
+  assert.strictEqual(pooled.length, 100)
+
+  // a pooled block stays in use while a view re-created after memory
+  // growth is alive, even when the original buffer is collected
+  let original = test_typedarray.CreateBuffer(100)
+  const pooledRef = api.createMemoryViewRef(original)
+  test_typedarray.GrowMemory()
+  const grown = pooledRef.view
+  assert.notStrictEqual(grown, original)
+  original = null
+  for (let i = 0; i < 5; ++i) {
+    await new Promise((resolve) => setImmediate(resolve))
+    global.gc()
+  }
+  await new Promise((resolve) => setImmediate(resolve))
+  for (let i = 0; i < 16; ++i) {
+    assert.notStrictEqual(test_typedarray.BufferAddress(100), pooledRef.address)
+  }
+  assert.ok(grown.every((b) => b === 0x5a))
+
+  // releasing through one view releases the block for all of them
+  const twice = test_typedarray.CreateBuffer(100)
+  const twiceRef = api.createMemoryViewRef(twice)
+  test_typedarray.GrowMemory()
+  assert.strictEqual(test_typedarray.ReleaseBuffer(twiceRef.view), 0)
+  assert.strictEqual(test_typedarray.ReleaseBuffer(twice), 1 /* napi_invalid_arg */)
+
+  // blocks too large for the pool are left to the finalizer
+  const large = test_typedarray.CreateBuffer(100000)
+  assert.strictEqual(test_typedarray.ReleaseBuffer(large), 1 /* napi_invalid_arg */)
+  assert.strictEqual(test_typedarray.ReleaseBuffer(Buffer.alloc(16)), 1 /* napi_invalid_arg */)
+
+  // a released block goes to the next buffer of the same size class,
+  // writing through the released buffer only reaches that buffer's data
+  const released = test_typedarray.CreateBuffer(100)
+  const releasedAddress = api.createMemoryViewRef(released).address
+  assert.strictEqual(test_typedarray.ReleaseBuffer(released), 0)
+  const next = test_typedarray.CreateBuffer(120)
+  assert.strictEqual(api.createMemoryViewRef(next).address, releasedAddress)
+  released.fill(0xcd)
+  assert.ok(next.subarray(0, 100).every((b) => b === 0xcd))
+  assert.ok(next.subarray(100).every((b) => b === 0x5a))
+  assert.strictEqual(test_typedarray.ReleaseBuffer(next), 0)
+  // malloc is still intact
+  assert.strictEqual(test_typedarray.BufferPool().length, 100)
+  assert.strictEqual(test_typedarray.CreateBuffer(100000).length, 100000)
+
+  const [memorySize, heapSize, usedSize, freeSize, largestFreeSize, freePageSize] = test_typedarray.HeapStatistics()
+  assert.ok(memorySize > 0)
+  assert.strictEqual(memorySize % 65536, 0)
+  assert.ok(heapSize <= memorySize)
+  assert.ok(usedSize + freeSize <= heapSize)
+  assert.ok(largestFreeSize <= freeSize)
+  if (largestFreeSize > 0) {
+    // the freed 1MiB block spans whole pages
+    assert.ok(freePageSize >= 65536)
+  }
+
   const buffer = test_typedarray.NullArrayBuffer()
   assert.ok(buffer instanceof Uint8Array)
   assert.strictEqual(buffer.length, 0)
@@ -216,6 +216,17 @@ static napi_value testAdjustExternalMemory(napi_env env, napi_callback_info info
   return result;
 }
 
+static napi_value adjustExternalMemory(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  int64_t change_in_bytes;
+  int64_t adjustedValue;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_int64(env, argv[0], &change_in_bytes));
+  NAPI_CALL(env, napi_adjust_external_memory(env, change_in_bytes, &adjustedValue));
+  return NULL;
+}
+
 static napi_value testNapiRun(napi_env env, napi_callback_info info) {
   napi_value script, result;
   size_t argc = 1;
@@ -322,6 +333,7 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("finalizeWasCalled", finalize_was_called),
     DECLARE_NAPI_PROPERTY("derefItemWasCalled", deref_item_was_called),
     DECLARE_NAPI_PROPERTY("testAdjustExternalMemory", testAdjustExternalMemory),
+    DECLARE_NAPI_PROPERTY("adjustExternalMemory", adjustExternalMemory),
 #ifdef __wasm__
     {
       .utf8name = "dynamicallyInitialized",
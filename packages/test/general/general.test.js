@@ -80,6 +80,23 @@ module.exports = load('general').then(async test_general => {
   assert.strictEqual(typeof adjustedValue, 'number')
   assert(adjustedValue > 0)
 
+  if (!process.env.EMNAPI_TEST_NATIVE) {
+    const context = require('../../runtime').getDefaultContext()
+    context.resetExternalMemoryStats()
+    const before = context.getExternalMemoryStats().current
+    context.setExternalMemoryThresholds({ drain: 1024 })
+    test_general.adjustExternalMemory(2048)
+    let stats = context.getExternalMemoryStats()
+    assert.strictEqual(stats.current, before + 2048)
+    assert.strictEqual(stats.finalizerDrains, 1)
+    assert.strictEqual(stats.gcRequests, 0)
+    test_general.adjustExternalMemory(-2048)
+    stats = context.getExternalMemoryStats()
+    assert.strictEqual(stats.current, before)
+    assert.strictEqual(stats.peak, before + 2048)
+    context.setExternalMemoryThresholds({})
+  }
+
   async function runGCTests () {
   // Ensure that garbage collecting an object with a wrapped native item results
   // in the finalize callback being called.
@@ -0,0 +1,174 @@
+#include <stdint.h>
+#include <node_api.h>
+#include "../common.h"
+
+void* malloc(size_t size);
+void free(void* p);
+
+// Every round queues WORK_COUNT async works. Work k frees the blocks that
+// work k - 1 allocated in the previous round, on whichever thread that
+// ran, then allocates blocks for work k + 1 of the next round. In
+// between it churns through small blocks of its own.
+
+#define WORK_COUNT 4
+#define BLOCK_COUNT 256
+#define CHURN_COUNT 4096
+#define LIVE_COUNT 32
+
+typedef struct {
+  napi_async_work work;
+  int32_t index;
+  int32_t errors;
+} stress_work;
+
+static stress_work works[WORK_COUNT];
+static unsigned char* handoff[2][WORK_COUNT][BLOCK_COUNT];
+static int32_t current_round;
+static int32_t pending;
+static napi_ref round_callback;
+
+static uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1103515245u + 12345u;
+  return *seed >> 8;
+}
+
+// 8 to 1031 bytes, the size is stored in the first 4 bytes
+// and the rest is filled with `tag`
+static unsigned char* AllocBlock(uint32_t* seed, unsigned char tag) {
+  uint32_t size = 8 + NextRandom(seed) % 1024;
+  unsigned char* block = (unsigned char*) malloc(size);
+  if (block == NULL) return NULL;
+  *(uint32_t*) block = size;
+  for (uint32_t i = 4; i < size; i++) block[i] = tag;
+  return block;
+}
+
+static int32_t FreeBlock(unsigned char* block, unsigned char tag) {
+  int32_t errors = 0;
+  uint32_t size = *(uint32_t*) block;
+  if (size < 8 || size >= 8 + 1024) return 1;
+  for (uint32_t i = 4; i < size; i++) {
+    if (block[i] != tag) {
+      errors++;
+      break;
+    }
+  }
+  free(block);
+  return errors;
+}
+
+static unsigned char Tag(int32_t round, int32_t index) {
+  return (unsigned char) (round * 31 + index + 1);
+}
+
+static void StressExecute(napi_env env, void* data) {
+  stress_work* w = (stress_work*) data;
+  int32_t round = current_round;
+  uint32_t seed = (uint32_t) (round * WORK_COUNT + w->index + 1);
+  unsigned char** incoming = handoff[round & 1][w->index];
+  unsigned char** outgoing = handoff[(round + 1) & 1][(w->index + 1) % WORK_COUNT];
+  unsigned char* live[LIVE_COUNT];
+  unsigned char tag = Tag(round, w->index);
+  int32_t i;
+
+  w->errors = 0;
+  if (round > 0) {
+    unsigned char previous = Tag(round - 1, (w->index + WORK_COUNT - 1) % WORK_COUNT);
+    for (i = 0; i < BLOCK_COUNT; i++) {
+      if (incoming[i] == NULL) {
+        w->errors++;
+        continue;
+      }
+      w->errors += FreeBlock(incoming[i], previous);
+      incoming[i] = NULL;
+    }
+  }
+
+  for (i = 0; i < LIVE_COUNT; i++) live[i] = NULL;
+  for (i = 0; i < CHURN_COUNT; i++) {
+    uint32_t slot = NextRandom(&seed) % LIVE_COUNT;
+    if (live[slot] != NULL) w->errors += FreeBlock(live[slot], tag);
+    live[slot] = AllocBlock(&seed, tag);
+    if (live[slot] == NULL) w->errors++;
+  }
+  for (i = 0; i < LIVE_COUNT; i++) {
+    if (live[i] != NULL) w->errors += FreeBlock(live[i], tag);
+  }
+
+  for (i = 0; i < BLOCK_COUNT; i++) {
+    outgoing[i] = AllocBlock(&seed, tag);
+    if (outgoing[i] == NULL) w->errors++;
+  }
+}
+
+static void StressComplete(napi_env env, napi_status status, void* data) {
+  stress_work* w = (stress_work*) data;
+  NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, w->work));
+  w->work = NULL;
+  if (status != napi_ok) w->errors++;
+  if (--pending > 0) return;
+
+  int32_t errors = 0;
+  for (int32_t i = 0; i < WORK_COUNT; i++) errors += works[i].errors;
+  napi_value cb, result;
+  NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, round_callback, &cb));
+  NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, round_callback));
+  round_callback = NULL;
+  NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, errors, &result));
+  NAPI_CALL_RETURN_VOID(env, napi_call_function(env, cb, cb, 1, &result, NULL));
+}
+
+static napi_value Round(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], name;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_ASSERT(env, pending == 0, "Previous round is still running");
+  NAPI_CALL(env, napi_get_value_int32(env, argv[0], &current_round));
+  NAPI_CALL(env, napi_create_reference(env, argv[1], 1, &round_callback));
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, "MallocStress", NAPI_AUTO_LENGTH, &name));
+  for (int32_t i = 0; i < WORK_COUNT; i++) {
+    works[i].index = i;
+    NAPI_CALL(env, napi_create_async_work(env, NULL, name, StressExecute,
+        StressComplete, &works[i], &works[i].work));
+  }
+  pending = WORK_COUNT;
+  for (int32_t i = 0; i < WORK_COUNT; i++) {
+    NAPI_CALL(env, napi_queue_async_work(env, works[i].work));
+  }
+  return NULL;
+}
+
+// frees the blocks of the last round on the main thread
+static napi_value Cleanup(napi_env env, napi_callback_info info) {
+  int32_t errors = 0;
+  unsigned char** blocks;
+  napi_value result;
+  NAPI_ASSERT(env, pending == 0, "A round is still running");
+  for (int32_t k = 0; k < WORK_COUNT; k++) {
+    blocks = handoff[(current_round + 1) & 1][k];
+    unsigned char previous = Tag(current_round, (k + WORK_COUNT - 1) % WORK_COUNT);
+    for (int32_t i = 0; i < BLOCK_COUNT; i++) {
+      if (blocks[i] != NULL) {
+        errors += FreeBlock(blocks[i], previous);
+        blocks[i] = NULL;
+      }
+    }
+  }
+  NAPI_CALL(env, napi_create_int32(env, errors, &result));
+  return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NAPI_PROPERTY("Round", Round),
+    DECLARE_NAPI_PROPERTY("Cleanup", Cleanup),
+  };
+
+  NAPI_CALL(env, napi_define_properties(
+      env, exports, sizeof(properties) / sizeof(*properties), properties));
+
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,24 @@
+'use strict'
+const { load } = require('../util')
+const assert = require('assert')
+
+// bare wasm32 links every thread safe allocator of emnapi,
+// the other targets test the malloc of their libc
+const targets = process.env.EMNAPI_TEST_WASM32
+  ? ['malloc_mt_dlmalloc', 'malloc_mt_emmalloc', 'malloc_mt_tlmalloc']
+  : ['malloc_mt']
+
+async function main () {
+  for (const target of targets) {
+    const binding = await load(target)
+    for (let round = 0; round < 20; ++round) {
+      const errors = await new Promise((resolve) => {
+        binding.Round(round, resolve)
+      })
+      assert.strictEqual(errors, 0, `${target} round ${round}`)
+    }
+    assert.strictEqual(binding.Cleanup(), 0, target)
+  }
+}
+
+module.exports = main()
@@ -21,6 +21,12 @@ module.exports = load('number').then(test_number => {
   testNumber(986583)
   testNumber(-976675)
 
+  // Around the range of immediate integers
+  testNumber(Math.pow(2, 30) - 1)
+  testNumber(Math.pow(2, 30))
+  testNumber(-Math.pow(2, 30))
+  testNumber(-Math.pow(2, 30) - 1)
+
   testNumber(
     98765432213456789876546896323445679887645323232436587988766545658)
   testNumber(
@@ -51,6 +57,8 @@ module.exports = load('number').then(test_number => {
   testUint32(4294967297, 1)
   testUint32(17 * 4294967296 + 1, 1)
   testUint32(-1, 0xffffffff)
+  testUint32(Math.pow(2, 30) - 1)
+  testUint32(Math.pow(2, 30))
 
   // Validate documented behavior when value is retrieved as 32-bit integer with
   // `napi_get_value_int32`
@@ -65,6 +73,8 @@ module.exports = load('number').then(test_number => {
   // Test min/max int32 range
   testInt32(-Math.pow(2, 31))
   testInt32(Math.pow(2, 31) - 1)
+  testInt32(-Math.pow(2, 30))
+  testInt32(-Math.pow(2, 30) - 1)
 
   // Test overflow scenarios
   testInt32(4294967297, 1)
@@ -68,6 +68,40 @@ static napi_value NewScopeWithException(napi_env env, napi_callback_info info) {
   return NULL;
 }
 
+static napi_value NewManyHandles(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  uint32_t count;
+  uint32_t i;
+  napi_value output = NULL;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &count));
+  for (i = 0; i < count; ++i) {
+    NAPI_CALL(env, napi_create_object(env, &output));
+  }
+  return output;
+}
+
+// every handle lives in its own scope that is closed right away
+static napi_value NewManyScopes(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  uint32_t count;
+  uint32_t i;
+  napi_handle_scope scope;
+  napi_value output = NULL;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &count));
+  for (i = 0; i < count; ++i) {
+    NAPI_CALL(env, napi_open_handle_scope(env, &scope));
+    NAPI_CALL(env, napi_create_object(env, &output));
+    NAPI_CALL(env, napi_close_handle_scope(env, scope));
+  }
+  return NULL;
+}
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor properties[] = {
@@ -75,6 +109,8 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("NewScopeEscape", NewScopeEscape),
     DECLARE_NAPI_PROPERTY("NewScopeEscapeTwice", NewScopeEscapeTwice),
     DECLARE_NAPI_PROPERTY("NewScopeWithException", NewScopeWithException),
+    DECLARE_NAPI_PROPERTY("NewManyHandles", NewManyHandles),
+    DECLARE_NAPI_PROPERTY("NewManyScopes", NewManyScopes),
   };
 
   NAPI_CALL(env, napi_define_properties(
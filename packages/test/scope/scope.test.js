@@ -4,6 +4,7 @@
 'use strict'
 const assert = require('assert')
 const { load } = require('../util')
+const emnapi = require('../../runtime')
 
 const p = load('scope')
 module.exports = p.then(testHandleScope => {
@@ -17,4 +18,41 @@ module.exports = p.then(testHandleScope => {
       testHandleScope.NewScopeWithException(() => { throw new RangeError() })
     },
     RangeError)
+
+  if (process.env.EMNAPI_TEST_NATIVE) return
+
+  const context = emnapi.getDefaultContext()
+  const liveBefore = context.getHandleStats().liveHandles
+  context.resetHandleStats()
+  testHandleScope.NewScope()
+  let stats = context.getHandleStats()
+  assert.strictEqual(stats.liveHandles, liveBefore)
+  assert.ok(stats.peakHandles > liveBefore)
+  assert.ok(stats.peakScopeDepth >= 2)
+  assert.ok(stats.callbacks >= 1)
+
+  const reports = []
+  const limit = liveBefore + 100
+  context.setHandleSoftLimit(limit, (live, limit, name) => { reports.push({ live, limit, name }) })
+  testHandleScope.NewManyHandles(200)
+  testHandleScope.NewManyHandles(50)
+  context.setHandleSoftLimit(0)
+  testHandleScope.NewManyHandles(200)
+  assert.strictEqual(reports.length, 1)
+  assert.strictEqual(reports[0].live, limit)
+  assert.strictEqual(reports[0].limit, limit)
+  assert.strictEqual(typeof reports[0].name, 'string')
+
+  stats = context.getHandleStats()
+  assert.strictEqual(stats.liveHandles, liveBefore)
+  assert.ok(stats.peakHandles >= liveBefore + 200)
+  assert.ok(stats.maxHandlesCreatedPerCallback >= 200)
+
+  // handles of inner scopes that were already closed count as well
+  context.resetHandleStats()
+  testHandleScope.NewManyScopes(300)
+  stats = context.getHandleStats()
+  assert.strictEqual(stats.callbacks, 1)
+  assert.ok(stats.maxHandlesCreatedPerCallback >= 300)
+  assert.ok(stats.peakHandles < liveBefore + 300)
 })
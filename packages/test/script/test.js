@@ -18,7 +18,9 @@ const pthread = [
   'pool/**/*',
   'tsfn/**/*',
   'async_cleanup_hook/**/*',
-  'string/string-pthread.test.js'
+  'string/string-pthread.test.js',
+  'async/async-batch.test.js',
+  'tsfn/tsfn-batch.test.js'
 ]
 
 if (process.env.EMNAPI_TEST_NATIVE) {
@@ -26,6 +28,8 @@ if (process.env.EMNAPI_TEST_NATIVE) {
     ...ignore,
     'filename/**/*',
     'objwrap/objwrapref.test.js',
+    'async/async-batch.test.js',
+    'tsfn/tsfn-batch.test.js',
     // 'rust/**/*',
     '**/{emnapitest,node-addon-api}/**/*'
   ])]
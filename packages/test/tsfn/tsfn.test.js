@@ -5,8 +5,12 @@ const common = require('../common')
 const assert = require('assert')
 // const { fork } = require('child_process')
 
+// tsfn-batch.test.js runs the same tests against the
+// EMNAPI_ASYNC_WORK_BATCH_COMPLETE build
+const target = process.env.EMNAPI_TEST_ASYNC_BATCH ? 'tsfn_batch' : 'tsfn'
+
 async function main () {
-  const loadPromise = load('tsfn', { nodeBinding: require('@emnapi/node-binding') })
+  const loadPromise = load(target, { nodeBinding: require('@emnapi/node-binding') })
   const binding = await loadPromise
 
   const expectedArray = (function (arrayLength) {